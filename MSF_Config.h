@@ -15,11 +15,35 @@
 #define MSF_STR(x) MSF_STR2(x)
 
 //-------------------------------------------------------------------------------------------------
-// Set the maximum number of arguments that can be provided to any print statement. Mainly affects
-// stack space usage
+// Set the maximum number of arguments that can be provided to any print statement, calls with more
+// fail with ER_TooManyInputs. Arguments are indexed with 8 bits so this can't be more than 255.
 //-------------------------------------------------------------------------------------------------
 #if !defined(MSF_MAX_ARGUMENTS)
-#define MSF_MAX_ARGUMENTS 32
+#define MSF_MAX_ARGUMENTS 255
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Set the number of arguments that are handled with storage on the stack. Calls with more print
+// specifiers than this allocate storage for them with MSF_ALLOCATE. Mainly affects stack space usage
+//-------------------------------------------------------------------------------------------------
+#if !defined(MSF_INLINE_ARGUMENTS)
+#define MSF_INLINE_ARGUMENTS 8
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Allocator for calls with more than MSF_INLINE_ARGUMENTS print specifiers and for sinks printing an
+// argument longer than they can hold, the memory is freed again before the call returns. This is the
+// only memory the library allocates itself, output buffers only ever grow through the realloc
+// callbacks passed in to each call. Define these to use your own allocator, or define
+// MSF_ALLOCATE(aSize) as nullptr to have those calls fail with ER_AllocationFailed or
+// ER_PrintAllocationFailed instead.
+//-------------------------------------------------------------------------------------------------
+#if !defined(MSF_ALLOCATE)
+#define MSF_ALLOCATE(aSize) malloc(aSize)
+#endif
+
+#if !defined(MSF_FREE)
+#define MSF_FREE(aPointer) free(aPointer)
 #endif
 
 //-------------------------------------------------------------------------------------------------
@@ -36,6 +60,54 @@
 #define MSF_COPY_ALIGNMENT 4
 #endif
 
+//-------------------------------------------------------------------------------------------------
+// Opt-in cache of parsed format strings. Set to the number of entries to keep (power of 2) to
+// enable. Format strings are found by their address and checked against a hash of their contents,
+// so modified strings and recycled memory are parsed again. Older entries are evicted when the cache
+// is full.
+//-------------------------------------------------------------------------------------------------
+#if !defined(MSF_FORMAT_CACHE_SIZE)
+#define MSF_FORMAT_CACHE_SIZE 0
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Maximum number of print specifiers a format string can have to be cached. Affects the memory
+// used by each cache entry.
+//-------------------------------------------------------------------------------------------------
+#if !defined(MSF_FORMAT_CACHE_MAX_SPECIFIERS)
+#define MSF_FORMAT_CACHE_MAX_SPECIFIERS 8
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Use SIMD instructions to skip over literal text when parsing format strings and to copy runs of
+// ascii when converting strings between UTF types. SSE2 is used on x86/x64 and AVX2 when the
+// compiler is targeting it (i.e. -mavx2 or /arch:AVX2). Set to 0 to always use the scalar version.
+//-------------------------------------------------------------------------------------------------
+#if !defined(MSF_USE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MSF_USE_SIMD 1
+#else
+#define MSF_USE_SIMD 0
+#endif
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Support printing 128 bit integers (__int128 and unsigned __int128). Enabled by default when the
+// compiler provides them, which is gcc and clang on 64 bit targets. Set to 0 to disable.
+//-------------------------------------------------------------------------------------------------
+#if !defined(MSF_USE_INT128)
+#if defined(__SIZEOF_INT128__)
+#define MSF_USE_INT128 1
+#else
+#define MSF_USE_INT128 0
+#endif
+#endif
+
+#if MSF_USE_INT128
+__extension__ typedef __int128 MSF_Int128;
+__extension__ typedef unsigned __int128 MSF_UInt128;
+#endif
+
 //-------------------------------------------------------------------------------------------------
 // When pedantic error checking is enable, strings will have additional checks
 // i.e. "%++d" will error about the duplicate flags
@@ -125,14 +197,6 @@
 #define MSF_POINTER_PRINT_NIL 0
 #endif
 
-//-------------------------------------------------------------------------------------------------
-// If enabled then the epsilon modifier to check for rounding will be further decreased
-// by the precision of the number being printed.
-//-------------------------------------------------------------------------------------------------
-#if !MSF_FLOAT_EPSILON_AFFECTED_BY_PRECISION
-#define MSF_FLOAT_EPSILON_AFFECTED_BY_PRECISION 0
-#endif
-
 #endif // !MSF_FORMAT_LOCAL_PLATFORM
 
 //-------------------------------------------------------------------------------------------------
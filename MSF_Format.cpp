@@ -1,8 +1,12 @@
 #include "MSF_FormatStandardTypes.h"
+#include "MSF_FormatCache.h"
+#include "MSF_FormatSpan.h"
 #include "MSF_Assert.h"
 #include "MSF_UTF.h"
 #include "MSF_Utilities.h"
 #include <new>
+#include <stdlib.h>
+#include <string.h>
 
 #if _MSC_VER
 #define STRICT
@@ -23,13 +27,16 @@ template class MSF_StringFormatTemplate<wchar_t>;
 enum MSF_PrintResultType
 {
 	ER_NotEnoughSpace,
-	ER_TooManyInputs,
+	ER_TooManyInputs, // more than MSF_MAX_ARGUMENTS, which can't be raised past 255
 	ER_InconsistentPrintType,
 	ER_DuplicateFlag,
 	ER_InvalidPrintCharacter,
 	ER_TypeMismatch,
 	ER_UnregisteredChar,
 	ER_WildcardType,
+	ER_AllocationFailed,
+	ER_PrintAllocationFailed,
+	ER_SpanSpecifierCount,
 
 	// csharp errors
 	ER_UnexpectedBrace,
@@ -51,6 +58,9 @@ static char const* thePrintErrors[] =
 	"ER_TypeMismatch: Type mismatch for print character '{0:c}' at {1}",
 	"ER_UnregisteredChar: Unregistered print character  '{0:c}' at {1}",
 	"ER_WildcardType: Incorrect type specified for wildcard flag at {1}",
+	"ER_AllocationFailed: Failed to allocate space for {0} print specifiers",
+	"ER_PrintAllocationFailed: Failed to allocate space to print {0} chars at {1}",
+	"ER_SpanSpecifierCount: Span format strings must have exactly 1 print specifier, error at {1}",
 
 	"ER_UnexpectedBrace: Unexpected '}}' at {1}. Did you forget to double up your braces?",
 	"ER_IndexOutOfRange: Requested print index is {1} is out of range",
@@ -274,6 +284,9 @@ namespace MSF_CustomPrint
 			RegisterDefaultPrintFunction('d', MSF_StringFormatInt::ValidTypes, printer);
 			RegisterPrintFunction('i', MSF_StringFormatInt::ValidTypes, printer);
 			RegisterPrintFunction('u', MSF_StringFormatInt::ValidTypes, printer);
+#if MSF_USE_INT128
+			RegisterTypeCopyLength('d', MSF_StringFormatInt::CopyLength);
+#endif
 		}
 
 		{
@@ -293,13 +306,24 @@ namespace MSF_CustomPrint
 			RegisterPrintFunction('X', MSF_StringFormatInt::ValidTypes, printer);
 		}
 
+		{
+			MSF_CustomPrinter printer{
+				MSF_StringFormatInt::ValidateBinary, MSF_StringFormatInt::ValidateBinary, MSF_StringFormatInt::ValidateBinary,
+				MSF_StringFormatInt::PrintUTF8, MSF_StringFormatInt::PrintUTF16, MSF_StringFormatInt::PrintUTF32
+			};
+			RegisterPrintFunction('b', MSF_StringFormatInt::ValidTypes, printer);
+			RegisterPrintFunction('B', MSF_StringFormatInt::ValidTypes, printer);
+		}
+
 		{
 			MSF_CustomPrinter printer{
 				MSF_StringFormatInt::ValidatePointer, MSF_StringFormatInt::ValidatePointer, MSF_StringFormatInt::ValidatePointer,
 				MSF_StringFormatInt::PrintUTF8, MSF_StringFormatInt::PrintUTF16, MSF_StringFormatInt::PrintUTF32
 			};
-			RegisterPrintFunction('p', MSF_StringFormatInt::ValidTypes, printer);
-			RegisterPrintFunction('P', MSF_StringFormatInt::ValidTypes, printer);
+			RegisterPrintFunction('p', MSF_StringFormatInt::PointerValidTypes, printer);
+			RegisterPrintFunction('P', MSF_StringFormatInt::PointerValidTypes, printer);
+			static_assert(MSF_StringFormatInt::PointerValidTypes == MSF_CharToTypes<'p'>::Type, "Runtime pointer types must match compile time validation");
+			static_assert(MSF_StringFormatInt::PointerValidTypes == MSF_CharToTypes<'P'>::Type, "Runtime pointer types must match compile time validation");
 		}
 
 		{
@@ -311,8 +335,12 @@ namespace MSF_CustomPrint
 			RegisterPrintFunction('E', MSF_StringFormatFloat::ValidTypes, printer);
 			RegisterPrintFunction('f', MSF_StringFormatFloat::ValidTypes, printer);
 			RegisterPrintFunction('F', MSF_StringFormatFloat::ValidTypes, printer);
-			RegisterDefaultPrintFunction('g', MSF_StringFormatFloat::ValidTypes, printer);
+			RegisterPrintFunction('g', MSF_StringFormatFloat::ValidTypes, printer);
 			RegisterPrintFunction('G', MSF_StringFormatFloat::ValidTypes, printer);
+			RegisterDefaultPrintFunction('r', MSF_StringFormatFloat::ValidTypes, printer);
+			RegisterPrintFunction('R', MSF_StringFormatFloat::ValidTypes, printer);
+			RegisterPrintFunction('a', MSF_StringFormatFloat::ValidTypes, printer);
+			RegisterPrintFunction('A', MSF_StringFormatFloat::ValidTypes, printer);
 		}
 
 		return true;
@@ -363,17 +391,24 @@ namespace MSF_CustomPrint
 		return MSF_PrintResult(maxLength);
 	}
 	//-------------------------------------------------------------------------------------------------
+	// Print validated print data with the printer registered for its character. Built in characters
+	// go through the table too, switching on them directly measured no faster even fully inlined.
+	//-------------------------------------------------------------------------------------------------
+	template <typename Char>
+	size_t Print(Char* aBuffer, Char const* aBufferEnd, MSF_PrintData const& aData)
+	{
+		return theRegisteredChars[GetCharIndex(aData.myPrintChar)].Printer.Print(aBuffer, aBufferEnd, aData);
+	}
+	//-------------------------------------------------------------------------------------------------
 	// Print a character type, useful for chaining custom types into standard types
 	//-------------------------------------------------------------------------------------------------
 	template <typename Char>
 	size_t PrintTypeShared(char aChar, Char* aBuffer, Char const* aBufferEnd, MSF_PrintData const& aData, MSF_StringFormatType const& aValue)
 	{
-		RegisteredChar const& registered = theRegisteredChars[GetCharIndex(aChar)];
-
 		MSF_PrintData tmp = aData;
 		tmp.myPrintChar = aChar;
 		tmp.myValue = &aValue;
-		return registered.Printer.Print(aBuffer, aBufferEnd, tmp);
+		return Print(aBuffer, aBufferEnd, tmp);
 	}
 	size_t PrintType(char aChar, char* aBuffer, char const* aBufferEnd, MSF_PrintData const& aData, MSF_StringFormatType const& aValue)
 	{
@@ -441,11 +476,96 @@ namespace MSF_CustomPrint
 		return (GetErrorFlags() & MSF_ErrorFlags::RelaxedCSharpFormat) != 0;
 	}
 
+	//-------------------------------------------------------------------------------------------------
+	// Lookup table for decoding printf specifiers. Flags map straight to their print flag, print characters
+	// are grouped into classes and each size modifier lists the classes that may follow it.
+	// i.e. 'h' accepts integers, counts and text (%hd, %hn, %hs), 'hh' only integers and counts (%hhd, %hhn)
+	//-------------------------------------------------------------------------------------------------
+	enum MSF_PrintfClass : uint8_t
+	{
+		PRINTF_INTEGER = 0x01,	// d i o u x X b B
+		PRINTF_COUNT = 0x02,	// n
+		PRINTF_TEXT = 0x04,		// s c
+		PRINTF_FLOAT = 0x08,	// f F e E a A g G
+	};
+
+	struct MSF_PrintfCharInfo
+	{
+		uint8_t myFlag; // print flag set by this character
+		uint8_t myClass; // see MSF_PrintfClass
+		uint8_t myModifier; // classes that can follow this character as a size modifier
+		uint8_t myDoubleModifier; // classes that can follow this character when doubled (hh, ll)
+	};
+
+	// Single expression constexpr functions so the table below can be built as a c++11 aggregate
+	constexpr bool MSF_PrintfIsOneOf(char const* aList, int aChar)
+	{
+		return *aList && (*aList == aChar || MSF_PrintfIsOneOf(aList + 1, aChar));
+	}
+
+	constexpr uint8_t MSF_PrintfFlag(int aChar)
+	{
+		return uint8_t(
+			aChar == '-' ? PRINT_LEFTALIGN :
+			aChar == '+' ? PRINT_SIGN :
+			aChar == ' ' ? PRINT_BLANK :
+			aChar == '#' ? PRINT_PREFIX :
+			aChar == '0' ? PRINT_ZERO : 0);
+	}
+
+	constexpr uint8_t MSF_PrintfClass(int aChar)
+	{
+		return uint8_t(
+			MSF_PrintfIsOneOf("diouxXbB", aChar) ? PRINTF_INTEGER :
+			aChar == 'n' ? PRINTF_COUNT :
+			MSF_PrintfIsOneOf("sc", aChar) ? PRINTF_TEXT :
+			MSF_PrintfIsOneOf("fFeEaAgG", aChar) ? PRINTF_FLOAT : 0);
+	}
+
+	constexpr uint8_t MSF_PrintfModifier(int aChar)
+	{
+		return uint8_t(
+			aChar == 'h' ? PRINTF_INTEGER | PRINTF_COUNT | PRINTF_TEXT :
+			aChar == 'l' ? PRINTF_INTEGER | PRINTF_COUNT | PRINTF_TEXT | PRINTF_FLOAT :
+			MSF_PrintfIsOneOf("Ijtz", aChar) ? PRINTF_INTEGER : // I is optionally I32 or I64
+			aChar == 'L' ? PRINTF_FLOAT :
+			aChar == 'w' ? PRINTF_TEXT : 0);
+	}
+
+	constexpr uint8_t MSF_PrintfDoubleModifier(int aChar)
+	{
+		return uint8_t(aChar == 'h' || aChar == 'l' ? PRINTF_INTEGER | PRINTF_COUNT : 0);
+	}
+
+#define MSF_PRINTF_INFO(c) { MSF_PrintfFlag(c), MSF_PrintfClass(c), MSF_PrintfModifier(c), MSF_PrintfDoubleModifier(c) }
+#define MSF_PRINTF_INFO8(c) MSF_PRINTF_INFO(c), MSF_PRINTF_INFO(c + 1), MSF_PRINTF_INFO(c + 2), MSF_PRINTF_INFO(c + 3), \
+	MSF_PRINTF_INFO(c + 4), MSF_PRINTF_INFO(c + 5), MSF_PRINTF_INFO(c + 6), MSF_PRINTF_INFO(c + 7)
+#define MSF_PRINTF_INFO64(c) MSF_PRINTF_INFO8(c), MSF_PRINTF_INFO8(c + 8), MSF_PRINTF_INFO8(c + 16), MSF_PRINTF_INFO8(c + 24), \
+	MSF_PRINTF_INFO8(c + 32), MSF_PRINTF_INFO8(c + 40), MSF_PRINTF_INFO8(c + 48), MSF_PRINTF_INFO8(c + 56)
+
+	struct MSF_PrintfTable
+	{
+		// Anything outside of ascii maps to the null character which has no meaning
+		template <typename Char>
+		constexpr MSF_PrintfCharInfo const& operator[](Char aChar) const
+		{
+			return myInfo[(uint32_t)aChar < 128 ? (uint32_t)aChar : 0];
+		}
+
+		MSF_PrintfCharInfo myInfo[128];
+	};
+
+	static constexpr MSF_PrintfTable thePrintfTable = { { MSF_PRINTF_INFO64(0), MSF_PRINTF_INFO64(64) } };
+
+#undef MSF_PRINTF_INFO64
+#undef MSF_PRINTF_INFO8
+#undef MSF_PRINTF_INFO
+
 	//-------------------------------------------------------------------------------------------------
 	// Normal printf
 	//-------------------------------------------------------------------------------------------------
 	template <typename Char>
-	MSF_PrintResult SetupPrintfInfo(MSF_PrintData& aPrintData, Char const*& anInput, uint32_t& anInputIndex, uint32_t anInputCount)
+	MSF_PrintResult SetupPrintfInfo(MSF_FormatSpecifier& aSpecifier, Char const*& anInput, uint32_t& anInputIndex, uint32_t anInputCount)
 	{
 		// gather the parts
 		// [flags] [width] [.precision] type
@@ -454,38 +574,23 @@ namespace MSF_CustomPrint
 		// is known in the format type.  this also frees up
 		// more room for custom types
 
+		// Read Flags
+		for (;;)
+		{
+			Char const character = *anInput;
+			uint8_t const flag = thePrintfTable[character].myFlag;
+			if (!flag)
+				break;
+
 #if MSF_ERROR_PEDANTIC
-#define SET_FLAG(flag) { if (aPrintData.myFlags & flag) return MSF_PrintResult(ER_DuplicateFlag, character); aPrintData.myFlags |= flag; }
-#else
-#define SET_FLAG(flag) aPrintData.myFlags |= flag;
+			if (aSpecifier.myFlags & flag)
+				return MSF_PrintResult(ER_DuplicateFlag, character);
 #endif
 
-		// Read Flags
-		for (Char character = *anInput; character; character = *++anInput)
-		{
-			// read until non-flag is found
-			switch (character)
-			{
-			case '-':
-				SET_FLAG(PRINT_LEFTALIGN);
-				aPrintData.myFlags &= ~PRINT_ZERO;
-				continue;
-			case '+':
-				SET_FLAG(PRINT_SIGN);
-				continue;
-			case ' ':
-				SET_FLAG(PRINT_BLANK);
-				continue;
-			case '#':
-				SET_FLAG(PRINT_PREFIX);
-				continue;
-			case '0':
-				if (!(aPrintData.myFlags & PRINT_LEFTALIGN))
-					SET_FLAG(PRINT_ZERO);
-				continue;
-			}
-			// no more flags
-			break;
+			// '-' invalidates '0', whichever comes first
+			uint8_t const flags = aSpecifier.myFlags | flag;
+			aSpecifier.myFlags = (flags & PRINT_LEFTALIGN) ? (flags & ~PRINT_ZERO) : flags;
+			++anInput;
 		}
 
 		// Width and precision
@@ -500,21 +605,12 @@ namespace MSF_CustomPrint
 			{
 				++anInput;
 
-				if ((aPrintData.myValue->myType & MSF_StringFormatInt::ValidTypes) == 0)
-					return MSF_PrintResult(ER_WildcardType);
-
 				if (anInputIndex == anInputCount)
 					return MSF_PrintResult(ER_IndexOutOfRange, anInputIndex);
 
-				switch (aPrintData.myValue->myType)
-				{
-				case MSF_StringFormatType::Type8: value = aPrintData.myValue->myValue8; break;
-				case MSF_StringFormatType::Type16: value = aPrintData.myValue->myValue16; break;
-				case MSF_StringFormatType::Type32: value = aPrintData.myValue->myValue32; break;
-				case MSF_StringFormatType::Type64: value = (uint32_t)aPrintData.myValue->myValue32; break; // sure hope someone isn't trying 2gb+ width or precision O.o
-				}
-
-				++aPrintData.myValue;
+				// the value is read when binding, the wildcard argument comes first so the printed argument moves along
+				aSpecifier.myWildcards |= i ? WILDCARD_PRECISION : WILDCARD_WIDTH;
+				++aSpecifier.myArgument;
 				++anInputIndex;
 			}
 			else
@@ -525,150 +621,62 @@ namespace MSF_CustomPrint
 
 			if (!i && *anInput == '.')
 			{
-				aPrintData.myFlags |= PRINT_PRECISION;
+				aSpecifier.myFlags |= PRINT_PRECISION;
 				++anInput;
 			}
 			else
 				break;
 		}
 
-		// Read print character
-		switch (Char character = *anInput++)
+		// Read print character, skipping any size modifier since the size is already known from the type
+		Char character = *anInput++;
+		uint8_t accepted = thePrintfTable[character].myModifier;
+		if (accepted)
 		{
-		case 'I': // look for I[(32|64)](d|i|o|u|x|X)
-			{
-				int advance = 0;
-				if ((anInput[0] == '3' && anInput[1] == '2') ||
-					(anInput[0] == '6' && anInput[1] == '4'))
-				{
-					advance = 2;
-				}
-
-				Char const next = anInput[advance];
-				if (next == 'd' || next == 'i' || next == 'o' || next == 'u' || next == 'x' || next == 'X')
-				{
-					character = next;
-					anInput += advance + 1;
-				}
-			}
-			goto do_print;
-
-		case 'h': // look for (h|hh)(d|i|o|u|x|X|n) or h(s|c)
-			if (anInput[0] == 'h')
-			{
-				Char const next = anInput[1];
-				if (next == 'd' || next == 'i' || next == 'o' || next == 'u' || next == 'x' || next == 'X' || next == 'n')
-				{
-					// skip hh
-					character = next;
-					anInput += 2;
-				}
-			}
-			else
-			{
-				Char const next = anInput[0];
-				if (next == 'd' || next == 'i' || next == 'o' || next == 'u' || next == 'x' || next == 'X' || next == 'n' ||
-					next == 's' || next == 'c')
-				{
-					// skip h
-					character = next;
-					anInput += 1;
-				}
-			}
-			goto do_print;
-
-		case 'l': // look for (l|ll)(d|i|o|u|x|X|n) or l(s|c|f|F|e|E|a|A|g|G)
-			if (anInput[0] == 'l')
+			uint32_t advance = 0;
+			if (*anInput == character && thePrintfTable[character].myDoubleModifier)
 			{
-				Char const next = anInput[1];
-				if (next == 'd' || next == 'i' || next == 'o' || next == 'u' || next == 'x' || next == 'X' || next == 'n')
-				{
-					// skip ll
-					character = next;
-					anInput += 2;
-				}
-			}
-			else
-			{
-				Char const next = anInput[0];
-				if (next == 'd' || next == 'i' || next == 'o' || next == 'u' || next == 'x' || next == 'X' || next == 'n' ||
-					next == 's' || next == 'c' ||
-					next == 'f' || next == 'F' || next == 'e' || next == 'E' || next == 'a' || next == 'A' || next == 'g' || next == 'G')
-				{
-					// skip l
-					character = next;
-					anInput += 1;
-				}
+				accepted = thePrintfTable[character].myDoubleModifier;
+				advance = 1;
 			}
-			goto do_print;
-
-		case 'j':
-		case 't':
-		case 'z': // look for (j|t|z)(d|i|o|u|x|X)
-		{
-			Char const next = anInput[0];
-			if (next == 'd' || next == 'i' || next == 'o' || next == 'u' || next == 'x' || next == 'X')
+			else if (character == 'I' &&
+				((anInput[0] == '3' && anInput[1] == '2') ||
+				 (anInput[0] == '6' && anInput[1] == '4')))
 			{
-				// skip l
-				character = next;
-				anInput += 1;
+				advance = 2;
 			}
-		}
-			goto do_print;
 
-		case 'L': // look for L(f|F|e|E|a|A|g|G)
-		{
-			Char const next = anInput[0];
-			if (next == 'f' || next == 'F' || next == 'e' || next == 'E' || next == 'a' || next == 'A' || next == 'g' || next == 'G')
+			// A modifier that isn't followed by something it applies to is treated as the print character
+			Char const next = anInput[advance];
+			if (thePrintfTable[next].myClass & accepted)
 			{
-				// skip l
 				character = next;
-				anInput += 1;
+				anInput += advance + 1;
 			}
 		}
-			goto do_print;
-
-		case 'w': // look for w(s|c)
+		else if (!MSF_IsAsciiAlpha(character))
 		{
-			Char const next = anInput[0];
-			if (next == 's' || next == 'c')
-			{
-				// skip l
-				character = next;
-				anInput += 1;
-			}
+			return MSF_PrintResult(ER_InvalidPrintCharacter, character ? character : '?');
 		}
-			goto do_print;
 
-		default:
-			if (!MSF_IsAsciiAlpha(character))
-			{
-				return MSF_PrintResult(ER_InvalidPrintCharacter, character ? character : '?');
-			}
-			else
-			{
-				do_print:
+		aSpecifier.myPrintChar = (char)character;
 
-				aPrintData.myPrintChar = (char)character;
+		static_assert(sizeof(aSpecifier.myWidth) == 2, "sizeof myWidth changed, update code");
+		MSF_ASSERT(widthPrecision[0] < UINT16_MAX);
+		aSpecifier.myWidth = (uint16_t)widthPrecision[0];
 
-				static_assert(sizeof(aPrintData.myWidth) == 2, "sizeof myWidth changed, update code");
-				MSF_ASSERT(widthPrecision[0] < UINT16_MAX);
-				aPrintData.myWidth = (uint16_t)widthPrecision[0];
+		static_assert(sizeof(aSpecifier.myPrecision) == 2, "sizeof myPrecision changed, update code");
+		MSF_ASSERT(widthPrecision[1] < UINT16_MAX);
+		aSpecifier.myPrecision = (uint16_t)widthPrecision[1];
 
-				static_assert(sizeof(aPrintData.myPrecision) == 2, "sizeof myPrecision changed, update code");
-				MSF_ASSERT(widthPrecision[1] < UINT16_MAX);
-				aPrintData.myPrecision = (uint16_t)widthPrecision[1];
-
-				return ValidateTypeShared<Char>(aPrintData, *aPrintData.myValue);
-			}
-		}
+		return MSF_PrintResult(0);
 	}
 
 	//-------------------------------------------------------------------------------------------------
 	// CSharp/hybrid style
 	//-------------------------------------------------------------------------------------------------
 	template <typename Char>
-	MSF_PrintResult SetupFormatInfo(MSF_PrintData& aPrintData, Char const*& anInput)
+	MSF_PrintResult SetupFormatInfo(MSF_FormatSpecifier& aSpecifier, Char const*& anInput)
 	{
 		// gather the parts
 		// https://docs.microsoft.com/en-us/dotnet/api/system.string.format?view=netframework-4.8#controlling-formatting
@@ -680,7 +688,7 @@ namespace MSF_CustomPrint
 			++anInput;
 			if (*anInput == '-')
 			{
-				aPrintData.myFlags |= PRINT_LEFTALIGN;
+				aSpecifier.myFlags |= PRINT_LEFTALIGN;
 				++anInput;
 			}
 
@@ -691,9 +699,9 @@ namespace MSF_CustomPrint
 			while (MSF_IsDigit(*anInput))
 				width = width * 10 + *(anInput++) - '0';
 
-			static_assert(sizeof(aPrintData.myWidth) == 2, "sizeof myWidth changed, update code");
+			static_assert(sizeof(aSpecifier.myWidth) == 2, "sizeof myWidth changed, update code");
 			MSF_ASSERT(width < UINT16_MAX);
-			aPrintData.myWidth = (uint16_t)width;
+			aSpecifier.myWidth = (uint16_t)width;
 		}
 
 		// Read formatting
@@ -703,21 +711,15 @@ namespace MSF_CustomPrint
 			if (!MSF_IsAsciiAlpha(*anInput))
 				return MSF_PrintResult(ER_InvalidPrintCharacter, *anInput ? *anInput : '?');
 
-			aPrintData.myPrintChar = (char)*(anInput++);
+			aSpecifier.myPrintChar = (char)*(anInput++);
 
 			uint32_t precision = 0;
 			while (MSF_IsDigit(*anInput))
 				precision = precision * 10 + *(anInput++) - '0';
 
-			static_assert(sizeof(aPrintData.myPrecision) == 2, "sizeof myPrecision changed, update code");
+			static_assert(sizeof(aSpecifier.myPrecision) == 2, "sizeof myPrecision changed, update code");
 			MSF_ASSERT(precision < UINT16_MAX);
-			aPrintData.myPrecision = (uint16_t)precision;
-		}
-		else if (aPrintData.myValue)
-		{
-			aPrintData.myPrintChar = GetTypeDefaultPrintCharacters(*aPrintData.myValue);
-			if (!aPrintData.myPrintChar)
-				return MSF_PrintResult(ER_UnsupportedType, aPrintData.myValue->myType, 0);
+			aSpecifier.myPrecision = (uint16_t)precision;
 		}
 
 		if (*anInput != '}')
@@ -725,37 +727,105 @@ namespace MSF_CustomPrint
 
 		++anInput;
 
-		return aPrintData.myValue ? ValidateTypeShared<Char>(aPrintData, *aPrintData.myValue) : MSF_PrintResult(0);
+		return MSF_PrintResult(0);
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Read the width or precision from a wildcard argument
+	//-------------------------------------------------------------------------------------------------
+	bool ReadWildcard(MSF_StringFormatType const& aValue, uint16_t& aValueOut)
+	{
+		uint32_t value;
+		switch (aValue.myType)
+		{
+		case MSF_StringFormatType::Type8: value = aValue.myValue8; break;
+		case MSF_StringFormatType::Type16: value = aValue.myValue16; break;
+		case MSF_StringFormatType::Type32: value = aValue.myValue32; break;
+		case MSF_StringFormatType::Type64: value = (uint32_t)aValue.myValue32; break; // sure hope someone isn't trying 2gb+ width or precision O.o
+		default: return false;
+		}
+
+		MSF_ASSERT(value < UINT16_MAX);
+		aValueOut = (uint16_t)value;
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Combine a parsed specifier with the arguments of this call, this is all the work that needs to
+	// happen per call when the format string was already parsed.
+	//-------------------------------------------------------------------------------------------------
+	template <typename Char>
+	MSF_PrintResult BindSpecifier(MSF_PrintData& aPrintData, MSF_FormatSpecifier const& aSpecifier, Char const* aString, MSF_StringFormatType const* someArgs, uint8_t someExtraFlags)
+	{
+		aPrintData.myStart = aString + aSpecifier.myStart;
+		aPrintData.myEnd = aString + aSpecifier.myEnd;
+		aPrintData.myValue = someArgs + aSpecifier.myArgument;
+		aPrintData.myFlags = aSpecifier.myFlags | someExtraFlags;
+		aPrintData.myWidth = aSpecifier.myWidth;
+		aPrintData.myPrecision = aSpecifier.myPrecision;
+		aPrintData.myPrintChar = aSpecifier.myPrintChar;
+
+		if (aSpecifier.myWildcards)
+		{
+			MSF_StringFormatType const* wildcard = aPrintData.myValue;
+			if (aSpecifier.myWildcards & WILDCARD_PRECISION)
+			{
+				if (!ReadWildcard(*--wildcard, aPrintData.myPrecision))
+					return MSF_PrintResult(ER_WildcardType);
+			}
+			if (aSpecifier.myWildcards & WILDCARD_WIDTH)
+			{
+				if (!ReadWildcard(*--wildcard, aPrintData.myWidth))
+					return MSF_PrintResult(ER_WildcardType);
+			}
+		}
+
+		if (!aPrintData.myPrintChar)
+		{
+			aPrintData.myPrintChar = GetTypeDefaultPrintCharacters(*aPrintData.myValue);
+			if (!aPrintData.myPrintChar)
+				return MSF_PrintResult(ER_UnsupportedType, aPrintData.myValue->myType, 0);
+		}
+
+		return ValidateTypeShared<Char>(aPrintData, *aPrintData.myValue);
 	}
 }
 
 //-------------------------------------------------------------------------------------------------
-// Helper class for constructing a formatted string
+// Walks a format string one print specifier at a time. Shared by both formatting engines so they
+// always agree on how a string is parsed.
 //-------------------------------------------------------------------------------------------------
 template <typename Char>
-class MSF_StringFormatter
+class MSF_FormatParser
 {
 public:
-	MSF_StringFormatter() : myPrintedCharacters(0) {}
+	MSF_FormatParser(Char const* aString, uint32_t anInputCount)
+		: myString(aString)
+		, myRead(aString)
+		, myInputCount(anInputCount)
+		, myInputIndex(0)
+		, myNumEscapes(0)
+		, myPrintMode(None)
+	{}
 
-	MSF_PrintResult PrepareFormatter(MSF_StringFormatTemplate<Char> const& aStringFormat)
+	//-------------------------------------------------------------------------------------------------
+	// Find the next print specifier, aFoundOut is false once the end of the string has been reached
+	//-------------------------------------------------------------------------------------------------
+	MSF_PrintResult Next(MSF_FormatSpecifier& aSpecifierOut, bool& aFoundOut)
 	{
-		uint32_t const inputCount = aStringFormat.NumArgs();
-		if (inputCount > MSF_MAX_ARGUMENTS)
-			return MSF_PrintResult(ER_TooManyInputs, inputCount, 0);
-
-		uint32_t inputIndex = 0;
-		MSF_StringFormatType const* aData = aStringFormat.GetArgs();
-		
-		myPrintString = aStringFormat.GetString();
-		Char const* str = myPrintString;
+		aFoundOut = false;
 
-		enum Mode { None, Auto, Specific };
-		Mode printMode = None;
+		Char const* str = myRead;
 		Char character;
 
-		for ((character = *str++); character; (character = *str++))
+		for (;;)
 		{
+			// jump straight over any literal text, only control characters and the terminator are interesting
+			str = MSF_FindFormatControl(str);
+			character = *str++;
+			if (!character)
+				break;
+
 			switch (character)
 			{
 			case '%':
@@ -766,15 +836,13 @@ public:
 				case '%':
 				case '{':
 					if (character != *str)
-						return MSF_PrintResult(ER_InvalidPrintCharacter, *str, int(str - myPrintString));
+						return MSF_PrintResult(ER_InvalidPrintCharacter, *str, int(str - myString));
 					++str;
+					++myNumEscapes;
 					break;
 				default:
-					MSF_PrintData& printData = myPrintData[myPrintedCharacters++];
-					printData.myFlags = 0; // initialize the whole first block
-					printData.myPrecision = 0;
-					printData.myWidth = 0;
-					printData.myStart = str - 1;// account for '%' or '{'
+					MSF_FormatSpecifier specifier = {}; // initialize the whole block
+					specifier.myStart = uint32_t(str - 1 - myString); // account for '%' or '{'
 
 					// look for position argument and print mode
 					Mode thisMode = Auto;
@@ -796,59 +864,52 @@ public:
 									break;
 							}
 
-							if (nextInputIndex >= inputCount)
+							if (nextInputIndex >= myInputCount)
 							{
 								// Only relax the error if it's at least 5 past the last input. This is to try to disambiguate
 								// between a user error and and non-print text. i.e. {123} is clearly out of range where {7} might just be a mistaken print
 								// This does mean there might be some small edge case errors like {12} with 7 real inputs will trigger an error vs a relax
-								if (nextInputIndex - inputCount > 5 && MSF_CustomPrint::IsRelaxedCSharpFormat())
-								{
-									--myPrintedCharacters;
+								if (nextInputIndex - myInputCount > 5 && MSF_CustomPrint::IsRelaxedCSharpFormat())
 									break;
-								}
 
 								return MSF_PrintResult(ER_IndexOutOfRange, nextInputIndex);
 							}
 
-							inputIndex = nextInputIndex;
+							myInputIndex = nextInputIndex;
 						}
 					}
 
 					// Check for inconsistent print modes
-					if (thisMode != printMode)
+					if (thisMode != myPrintMode)
 					{
-						if (printMode == None)
-							printMode = thisMode;
+						if (myPrintMode == None)
+							myPrintMode = thisMode;
 						else 
-							return MSF_PrintResult(ER_InconsistentPrintType, printMode, int((Char const*)printData.myStart - myPrintString));
+							return MSF_PrintResult(ER_InconsistentPrintType, myPrintMode, specifier.myStart);
 					}
 
-					if (printMode == Auto && inputIndex == inputCount)
+					if (myPrintMode == Auto && myInputIndex == myInputCount)
 					{
 						// Before considering out of range make sure this is a valid print statement and not an csharp looking one
 						if (character == '{' && MSF_CustomPrint::IsRelaxedCSharpFormat())
 						{
-							printData.myValue = nullptr;
-							if (MSF_CustomPrint::SetupFormatInfo(printData, str).HasError())
-							{
-								--myPrintedCharacters;
+							if (MSF_CustomPrint::SetupFormatInfo(specifier, str).HasError())
 								break;
-							}
 						}
 
-						return MSF_PrintResult(ER_IndexOutOfRange, inputIndex);
+						return MSF_PrintResult(ER_IndexOutOfRange, myInputIndex);
 					}
 
-					printData.myValue = aData + inputIndex;
+					specifier.myArgument = uint8_t(myInputIndex);
 
 					// Post increment in auto mode
-					if (printMode == Auto)
+					if (myPrintMode == Auto)
 					{
-						++inputIndex;
+						++myInputIndex;
 					}
 					
 					// Process any format specifiers
-					MSF_PrintResult result = character == '%' ? MSF_CustomPrint::SetupPrintfInfo(printData, str, inputIndex, inputCount) : MSF_CustomPrint::SetupFormatInfo(printData, str);
+					MSF_PrintResult result = character == '%' ? MSF_CustomPrint::SetupPrintfInfo(specifier, str, myInputIndex, myInputCount) : MSF_CustomPrint::SetupFormatInfo(specifier, str);
 
 					if (result.HasError())
 					{
@@ -858,25 +919,31 @@ public:
 								result.Error == ER_InvalidPrintCharacter ||
 								result.Error == ER_ExpectedClosingBrace)
 							{
-								--myPrintedCharacters;
 								break;
 							}
 						}
 
-						result.Location = int(str - myPrintString);
+						result.Location = int(str - myString);
 						return result;
 					}
 
-					printData.myEnd = str;
-					break;
+					specifier.myEnd = uint32_t(str - myString);
+
+					myRead = str;
+					aSpecifierOut = specifier;
+					aFoundOut = true;
+					return result;
 				}
 				break;
 			}
 			case '}':
 				if (*str == '}')
+				{
 					++str;
+					++myNumEscapes;
+				}
 				else if (!MSF_CustomPrint::IsRelaxedCSharpFormat())
-					return MSF_PrintResult(ER_UnexpectedBrace, 0, int(str - myPrintString));
+					return MSF_PrintResult(ER_UnexpectedBrace, 0, int(str - myString));
 
 				break;
 			}
@@ -885,82 +952,315 @@ public:
 		// we actually end up 1 past the end of the string which is actually ok count wise
 		MSF_HEAVY_ASSERT(!*(str-1));
 
-		// get the max size required
-		size_t requiredLength = str - myPrintString;
-		for (uint32_t i = 0; i < myPrintedCharacters; ++i)
-		{
-			requiredLength += myPrintData[i].myMaxLength - ((Char const*)myPrintData[i].myEnd - (Char const*)myPrintData[i].myStart);
-		}
+		myRead = str;
+		return MSF_PrintResult(0);
+	}
 
-		return MSF_PrintResult(requiredLength);
+	//-------------------------------------------------------------------------------------------------
+	// Length of the string including the null terminator, only valid once the end has been reached
+	//-------------------------------------------------------------------------------------------------
+	uint32_t GetLength() const { return uint32_t(myRead - myString); }
+
+	// Number of doubled control characters found so far, these are only printed once
+	uint32_t GetNumEscapes() const { return myNumEscapes; }
+
+private:
+	enum Mode { None, Auto, Specific };
+
+	Char const* myString;
+	Char const* myRead;
+	uint32_t myInputCount;
+	uint32_t myInputIndex;
+	uint32_t myNumEscapes;
+	Mode myPrintMode;
+};
+
+#if MSF_FORMAT_CACHE_SIZE
+//-------------------------------------------------------------------------------------------------
+// Anything that changes how the string is parsed must be part of the key
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+uint32_t MSF_GetFormatCacheKey(uint32_t anInputCount)
+{
+	return uint32_t(sizeof(Char)) | (anInputCount << 8) | (MSF_CustomPrint::IsRelaxedCSharpFormat() ? 1u << 31 : 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Cached strings are found by address and then checked against a hash of their contents, so a
+// string that was changed or memory reused for a different string never gets the old layout.
+// aLengthOut includes the null terminator, the same as the layout.
+//
+// The string is read a whole aligned word at a time, which can't cross in to another page, so the
+// hash costs a lot less than parsing. Characters before the string and after the terminator are
+// masked out.
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+MSF_NO_SANITIZE_ADDRESS uint64_t MSF_HashFormatString(Char const* aString, uint32_t& aLengthOut)
+{
+	uint64_t const multiplier = 0x9E3779B97F4A7C15ull;
+	uint64_t hash = 0xcbf29ce484222325ull;
+
+	// words can only be split in to characters on little endian and when the string is aligned
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	bool const bigEndian = true;
+#else
+	bool const bigEndian = false;
+#endif
+	if (bigEndian || (uintptr_t)aString % sizeof(Char) != 0)
+	{
+		Char const* read = aString;
+		while (*read)
+			hash = (hash ^ uint64_t(*read++)) * multiplier;
+
+		aLengthOut = uint32_t(read - aString) + 1;
+		return hash;
 	}
 
-	size_t FormatString(Char* aBuffer, size_t aBufferLength) const
+	// lowest and highest bit of every character, to find the terminator
+	uint64_t const low = ~uint64_t(0) / ((uint64_t(1) << (sizeof(Char) * 8)) - 1);
+	uint64_t const high = low << (sizeof(Char) * 8 - 1);
+
+	uintptr_t const offset = (uintptr_t)aString % sizeof(uint64_t);
+	uint64_t const* word = (uint64_t const*)((uintptr_t)aString - offset);
+	uint64_t value = *word | ((uint64_t(1) << (offset * 8)) - 1);
+
+	for (;;)
 	{
-		Char const* start = aBuffer;
-		Char const* end = aBuffer + aBufferLength;
-		Char const* read = myPrintString;
-		for (uint32_t i = 0; i < myPrintedCharacters; ++i)
+		// the lowest flagged character is always the first terminator
+		uint64_t const zeros = (value - low) & ~value & high;
+		if (zeros)
 		{
-			// copy segment between print markers
-			if (myPrintData[i].myStart > read)
-			{
-				while (read != myPrintData[i].myStart)
-				{
-					// if double control characters are found, skip one
-					if ((*read == '%' || *read == '{' || *read == '}') && read[0] == read[1])
-					{
-						++read;
-					}
+			uint32_t const bytes = (MSF_FirstSetBit(zeros) + 1) / 8 - uint32_t(sizeof(Char));
+			value &= bytes ? ~uint64_t(0) >> (64 - bytes * 8) : 0;
+			hash = (hash ^ value) * multiplier;
 
-					MSF_HEAVY_ASSERT(aBuffer < end);
-					*aBuffer++ = *read++;
-				}
-			}
+			aLengthOut = uint32_t(((char const*)word + bytes - (char const*)aString) / sizeof(Char)) + 1;
+			return hash;
+		}
 
-			int index = MSF_CustomPrint::GetCharIndex(myPrintData[i].myPrintChar);
-			aBuffer += MSF_CustomPrint::theRegisteredChars[index].Printer.Print(aBuffer, (Char const*)end, myPrintData[i]);
-			MSF_ASSERT(aBuffer < end);
+		hash = (hash ^ value) * multiplier;
+		value = *++word;
+	}
+}
+#endif
 
-			read = (Char const*)myPrintData[i].myEnd;
-		}
+//-------------------------------------------------------------------------------------------------
+// Copy literal text up to anEnd, stopping early if the buffer is full. Text between control characters
+// is copied in a single block and doubled control characters are only written once.
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+Char* MSF_CopyLiteral(Char* aBuffer, Char const* aBufferEnd, Char const*& aRead, Char const* anEnd)
+{
+	Char const* read = aRead;
+	while (read != anEnd && aBuffer != aBufferEnd)
+	{
+		Char const* control = MSF_FindFormatControl(read);
+		MSF_HEAVY_ASSERT(control <= anEnd);
 
-		while (*read)
+		if (control == read)
 		{
 			// if double control characters are found, skip one
-			if ((*read == '%' || *read == '{' || *read == '}') && read[0] == read[1])
+			if (read[0] == read[1])
 			{
 				++read;
 			}
 
-			MSF_HEAVY_ASSERT(aBuffer < end);
 			*aBuffer++ = *read++;
+			continue;
 		}
 
-		MSF_HEAVY_ASSERT(aBuffer < end);
-		*aBuffer = '\0';
+		size_t const count = MSF_IntMin(size_t(control - read), size_t(aBufferEnd - aBuffer));
+		MSF_CopyChars(aBuffer, aBufferEnd, read, count);
+		aBuffer += count;
+		read += count;
+	}
 
-		// Don't include the null terminator since we want character printed, not bytes used
-		return aBuffer - start;
+	aRead = read;
+	return aBuffer;
+}
+
+static_assert(MSF_MAX_ARGUMENTS <= UINT8_MAX, "Arguments are indexed with 8 bits");
+static_assert(MSF_INLINE_ARGUMENTS > 0, "At least one argument must be handled on the stack");
+
+//-------------------------------------------------------------------------------------------------
+// Helper class for constructing a formatted string
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+class MSF_StringFormatter
+{
+public:
+	explicit MSF_StringFormatter(MSF_SizingMode aSizingMode)
+		: myPrintData(myInlinePrintData)
+		, myCapacity(MSF_INLINE_ARGUMENTS)
+		, myPrintedCharacters(0)
+		, myExtraFlags(aSizingMode == MSF_SizingMode::Exact ? PRINT_EXACT_LENGTH : 0)
+	{}
+
+	~MSF_StringFormatter()
+	{
+		if (myPrintData != myInlinePrintData)
+			MSF_FREE(myPrintData);
 	}
 
-	void ProcessError(MSF_PrintResult anError, Char* aBuffer, size_t aBufferLength, size_t anOffset, Char* (*aReallocFunction)(Char*, size_t, void*), void* aUserData)
+	MSF_StringFormatter(MSF_StringFormatter const&) = delete;
+	MSF_StringFormatter& operator=(MSF_StringFormatter const&) = delete;
+
+	MSF_PrintResult PrepareFormatter(MSF_StringFormatTemplate<Char> const& aStringFormat)
 	{
-		MSF_ErrorMode errorMode = MSF_CustomPrint::GetErrorMode();
-		char errorMessage[256];
-		size_t errorLength = anError.ToString(errorMessage, aBufferLength);
+		uint32_t const inputCount = aStringFormat.NumArgs();
+		if (inputCount > MSF_MAX_ARGUMENTS)
+			return MSF_PrintResult(ER_TooManyInputs, inputCount, 0);
 
-		// Null terminate buffer if possible
-		if (aBuffer && aBufferLength)
-		{
-			aBuffer[MSF_IntMin(anOffset, aBufferLength-1)] = 0;
-		}
+		MSF_StringFormatType const* aData = aStringFormat.GetArgs();
+		
+		myPrintString = aStringFormat.GetString();
 
-		if (errorMode == MSF_ErrorMode::Assert)
-		{
-#if MSF_ASSERTS_ENABLED
-			if (!MSF_IsAsserting())
-			{
+		// Strings validated at compile time have already been parsed
+		if (aStringFormat.GetLength())
+			return BindLayout(aStringFormat.GetSpecifiers(), aStringFormat.NumSpecifiers(), aStringFormat.GetLength(), aStringFormat.NumEscapes(), aData);
+
+#if MSF_FORMAT_CACHE_SIZE
+		uint32_t const cacheKey = MSF_GetFormatCacheKey<Char>(inputCount);
+
+		uint32_t length;
+		uint64_t const hash = MSF_HashFormatString(myPrintString, length);
+
+		MSF_FormatLayout layout;
+		if (MSF_FormatCache::Find(myPrintString, cacheKey, hash, layout) && layout.myLength == length)
+			return BindLayout(layout.mySpecifiers, layout.myNumSpecifiers, layout.myLength, layout.myNumEscapes, aData);
+
+		layout.myNumSpecifiers = 0;
+#endif
+
+		MSF_FormatParser<Char> parser(myPrintString, inputCount);
+		for (;;)
+		{
+			MSF_FormatSpecifier specifier;
+			bool found;
+			MSF_PrintResult result = parser.Next(specifier, found);
+			if (result.HasError())
+				return result;
+			if (!found)
+				break;
+
+			if (myPrintedCharacters == myCapacity && !Reserve(myCapacity * 2))
+				return MSF_PrintResult(ER_AllocationFailed, myPrintedCharacters + 1, specifier.myStart);
+
+			result = BindSpecifier(specifier, aData);
+			if (result.HasError())
+				return result;
+
+#if MSF_FORMAT_CACHE_SIZE
+			// Too many specifiers will just stop the string from being cached
+			if (layout.myNumSpecifiers < MSF_FORMAT_CACHE_MAX_SPECIFIERS)
+				layout.mySpecifiers[layout.myNumSpecifiers] = specifier;
+			++layout.myNumSpecifiers;
+#endif
+		}
+
+		myLength = parser.GetLength();
+		myNumEscapes = parser.GetNumEscapes();
+
+#if MSF_FORMAT_CACHE_SIZE
+		if (layout.myNumSpecifiers <= MSF_FORMAT_CACHE_MAX_SPECIFIERS)
+		{
+			layout.myLength = myLength;
+			layout.myNumEscapes = myNumEscapes;
+			MSF_FormatCache::Insert(myPrintString, cacheKey, hash, layout);
+		}
+#endif
+
+		// get the max size required
+		size_t requiredLength = myLength;
+		for (uint32_t i = 0; i < myPrintedCharacters; ++i)
+		{
+			requiredLength += myPrintData[i].myMaxLength - ((Char const*)myPrintData[i].myEnd - (Char const*)myPrintData[i].myStart);
+		}
+
+		return MSF_PrintResult(requiredLength);
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Setup print data from an already parsed string, skips all parsing
+	//-------------------------------------------------------------------------------------------------
+	MSF_PrintResult BindLayout(MSF_FormatSpecifier const* someSpecifiers, uint32_t aNumSpecifiers, uint32_t aLength, uint32_t aNumEscapes, MSF_StringFormatType const* someArgs)
+	{
+		myLength = aLength;
+		myNumEscapes = aNumEscapes;
+
+		if (!Reserve(aNumSpecifiers))
+			return MSF_PrintResult(ER_AllocationFailed, aNumSpecifiers, 0);
+
+		size_t requiredLength = aLength;
+		for (uint32_t i = 0; i < aNumSpecifiers; ++i)
+		{
+			MSF_FormatSpecifier const& specifier = someSpecifiers[i];
+			MSF_PrintResult result = BindSpecifier(specifier, someArgs);
+			if (result.HasError())
+				return result;
+
+			requiredLength += myPrintData[i].myMaxLength - (specifier.myEnd - specifier.myStart);
+		}
+
+		return MSF_PrintResult(requiredLength);
+	}
+
+	MSF_PrintResult BindSpecifier(MSF_FormatSpecifier const& aSpecifier, MSF_StringFormatType const* someArgs)
+	{
+		MSF_PrintResult result = MSF_CustomPrint::BindSpecifier(myPrintData[myPrintedCharacters++], aSpecifier, myPrintString, someArgs, myExtraFlags);
+		if (result.HasError())
+			result.Location = aSpecifier.myEnd;
+		return result;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Number of doubled control characters that FormatString will skip, only needed for exact sizing
+	//-------------------------------------------------------------------------------------------------
+	size_t NumEscapes() const { return myNumEscapes; }
+
+	size_t FormatString(Char* aBuffer, size_t aBufferLength) const
+	{
+		Char const* start = aBuffer;
+		Char const* end = aBuffer + aBufferLength;
+		Char const* read = myPrintString;
+		for (uint32_t i = 0; i < myPrintedCharacters; ++i)
+		{
+			// copy segment between print markers
+			aBuffer = CopyLiteral(aBuffer, end, read, (Char const*)myPrintData[i].myStart);
+
+			aBuffer += MSF_CustomPrint::Print(aBuffer, end, myPrintData[i]);
+			MSF_ASSERT(aBuffer < end);
+
+			read = (Char const*)myPrintData[i].myEnd;
+		}
+
+		// length includes the null terminator
+		aBuffer = CopyLiteral(aBuffer, end, read, myPrintString + myLength - 1);
+
+		MSF_HEAVY_ASSERT(aBuffer < end);
+		*aBuffer = '\0';
+
+		// Don't include the null terminator since we want character printed, not bytes used
+		return aBuffer - start;
+	}
+
+	void ProcessError(MSF_PrintResult anError, Char* aBuffer, size_t aBufferLength, size_t anOffset, Char* (*aReallocFunction)(Char*, size_t, void*), void* aUserData)
+	{
+		MSF_ErrorMode errorMode = MSF_CustomPrint::GetErrorMode();
+		char errorMessage[256];
+		size_t errorLength = anError.ToString(errorMessage, aBufferLength);
+
+		// Null terminate buffer if possible
+		if (aBuffer && aBufferLength)
+		{
+			aBuffer[MSF_IntMin(anOffset, aBufferLength-1)] = 0;
+		}
+
+		if (errorMode == MSF_ErrorMode::Assert)
+		{
+#if MSF_ASSERTS_ENABLED
+			if (!MSF_IsAsserting())
+			{
 				MSF_ASSERT(false, "Error formatting string: %s", errorMessage);
 			}
 #endif
@@ -991,18 +1291,58 @@ public:
 	}
 
 private:
+	//-------------------------------------------------------------------------------------------------
+	// Copy a segment of literal text, without any escapes it is always a single block
+	//-------------------------------------------------------------------------------------------------
+	Char* CopyLiteral(Char* aBuffer, Char const* aBufferEnd, Char const* aRead, Char const* anEnd) const
+	{
+		if (myNumEscapes)
+			return MSF_CopyLiteral(aBuffer, aBufferEnd, aRead, anEnd);
 
-	MSF_PrintData myPrintData[MSF_MAX_ARGUMENTS];
+		MSF_HEAVY_ASSERT(aBuffer + (anEnd - aRead) < aBufferEnd);
+		MSF_CopyChars(aBuffer, aBufferEnd, aRead, anEnd - aRead);
+		return aBuffer + (anEnd - aRead);
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Make room for aCount print specifiers, anything already bound is moved over
+	//-------------------------------------------------------------------------------------------------
+	bool Reserve(uint32_t aCount)
+	{
+		if (aCount <= myCapacity)
+			return true;
+
+		MSF_PrintData* printData = (MSF_PrintData*)MSF_ALLOCATE(sizeof(MSF_PrintData) * aCount);
+		if (!printData)
+			return false;
+
+		for (size_t i = 0; i < myPrintedCharacters; ++i)
+			printData[i] = myPrintData[i];
+
+		if (myPrintData != myInlinePrintData)
+			MSF_FREE(myPrintData);
+
+		myPrintData = printData;
+		myCapacity = aCount;
+		return true;
+	}
+
+	MSF_PrintData* myPrintData;
+	uint32_t myCapacity;
+	MSF_PrintData myInlinePrintData[MSF_INLINE_ARGUMENTS];
 	Char const* myPrintString;
 	size_t myPrintedCharacters;
+	uint32_t myLength; // length of the format string including the null terminator
+	uint32_t myNumEscapes;
+	uint8_t myExtraFlags; // PRINT_EXACT_LENGTH when sizing exactly
 };
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 template <typename Char>
-intptr_t MSF_FormatStringShared(MSF_StringFormatTemplate<Char> const& aStringFormat, Char* aBuffer, size_t aBufferLength, size_t anOffset, Char* (*aReallocFunction)(Char*, size_t, void*), void* aUserData)
+intptr_t MSF_FormatStringShared(MSF_StringFormatTemplate<Char> const& aStringFormat, Char* aBuffer, size_t aBufferLength, size_t anOffset, Char* (*aReallocFunction)(Char*, size_t, void*), void* aUserData, MSF_SizingMode aSizingMode)
 {
-	MSF_StringFormatter<Char> formatter;
+	MSF_StringFormatter<Char> formatter(aSizingMode);
 	MSF_PrintResult result = formatter.PrepareFormatter(aStringFormat);
 
 	if (result.HasError())
@@ -1011,6 +1351,10 @@ intptr_t MSF_FormatStringShared(MSF_StringFormatTemplate<Char> const& aStringFor
 		return -1;
 	}
 
+	// The format string length counts escaped characters twice
+	if (aSizingMode == MSF_SizingMode::Exact)
+		result.MaxBufferLength -= formatter.NumEscapes();
+
 	if (result.MaxBufferLength + anOffset > aBufferLength || aBuffer == nullptr)
 	{
 		if (aReallocFunction == nullptr)
@@ -1035,12 +1379,12 @@ intptr_t MSF_FormatStringShared(MSF_StringFormatTemplate<Char> const& aStringFor
 	return printed;
 }
 //-------------------------------------------------------------------------------------------------
-intptr_t MSF_FormatString(MSF_StringFormat const& aStringFormat, char* aBuffer, size_t aBufferLength, size_t anOffset, char* (*aReallocFunction)(char*, size_t, void*), void* aUserData)
+intptr_t MSF_FormatString(MSF_StringFormat const& aStringFormat, char* aBuffer, size_t aBufferLength, size_t anOffset, char* (*aReallocFunction)(char*, size_t, void*), void* aUserData, MSF_SizingMode aSizingMode)
 {
-	return MSF_FormatStringShared(aStringFormat, aBuffer, aBufferLength, anOffset, aReallocFunction, aUserData);
+	return MSF_FormatStringShared(aStringFormat, aBuffer, aBufferLength, anOffset, aReallocFunction, aUserData, aSizingMode);
 }
 //-------------------------------------------------------------------------------------------------
-intptr_t MSF_FormatString(MSF_StringFormatUTF8 const& aStringFormat, char8_t* aBuffer, size_t aBufferLength, size_t anOffset, char8_t* (*aReallocFunction)(char8_t*, size_t, void*), void* aUserData)
+intptr_t MSF_FormatString(MSF_StringFormatUTF8 const& aStringFormat, char8_t* aBuffer, size_t aBufferLength, size_t anOffset, char8_t* (*aReallocFunction)(char8_t*, size_t, void*), void* aUserData, MSF_SizingMode aSizingMode)
 {
 	return MSF_FormatStringShared(
 		*(MSF_StringFormatTemplate<char> const*) & aStringFormat,
@@ -1048,20 +1392,21 @@ intptr_t MSF_FormatString(MSF_StringFormatUTF8 const& aStringFormat, char8_t* aB
 		aBufferLength,
 		anOffset,
 		(char* (*)(char*, size_t, void*))aReallocFunction,
-		aUserData);
+		aUserData,
+		aSizingMode);
 }
 //-------------------------------------------------------------------------------------------------
-intptr_t MSF_FormatString(MSF_StringFormatUTF16 const& aStringFormat, char16_t* aBuffer, size_t aBufferLength, size_t anOffset, char16_t* (*aReallocFunction)(char16_t*, size_t, void*), void* aUserData)
+intptr_t MSF_FormatString(MSF_StringFormatUTF16 const& aStringFormat, char16_t* aBuffer, size_t aBufferLength, size_t anOffset, char16_t* (*aReallocFunction)(char16_t*, size_t, void*), void* aUserData, MSF_SizingMode aSizingMode)
 {
-	return MSF_FormatStringShared(aStringFormat, aBuffer, aBufferLength, anOffset, aReallocFunction, aUserData);
+	return MSF_FormatStringShared(aStringFormat, aBuffer, aBufferLength, anOffset, aReallocFunction, aUserData, aSizingMode);
 }
 //-------------------------------------------------------------------------------------------------
-intptr_t MSF_FormatString(MSF_StringFormatUTF32 const& aStringFormat, char32_t* aBuffer, size_t aBufferLength, size_t anOffset, char32_t* (*aReallocFunction)(char32_t*, size_t, void*), void* aUserData)
+intptr_t MSF_FormatString(MSF_StringFormatUTF32 const& aStringFormat, char32_t* aBuffer, size_t aBufferLength, size_t anOffset, char32_t* (*aReallocFunction)(char32_t*, size_t, void*), void* aUserData, MSF_SizingMode aSizingMode)
 {
-	return MSF_FormatStringShared(aStringFormat, aBuffer, aBufferLength, anOffset, aReallocFunction, aUserData);
+	return MSF_FormatStringShared(aStringFormat, aBuffer, aBufferLength, anOffset, aReallocFunction, aUserData, aSizingMode);
 }
 //-------------------------------------------------------------------------------------------------
-intptr_t MSF_FormatString(MSF_StringFormatWChar const& aStringFormat, wchar_t* aBuffer, size_t aBufferLength, size_t anOffset, wchar_t* (*aReallocFunction)(wchar_t*, size_t, void*), void* aUserData)
+intptr_t MSF_FormatString(MSF_StringFormatWChar const& aStringFormat, wchar_t* aBuffer, size_t aBufferLength, size_t anOffset, wchar_t* (*aReallocFunction)(wchar_t*, size_t, void*), void* aUserData, MSF_SizingMode aSizingMode)
 {
 	return MSF_FormatStringShared(
 		*(MSF_StringFormatTemplate<MSF_WChar> const*)&aStringFormat,
@@ -1069,7 +1414,439 @@ intptr_t MSF_FormatString(MSF_StringFormatWChar const& aStringFormat, wchar_t* a
 		aBufferLength,
 		anOffset,
 		(MSF_WChar* (*)(MSF_WChar*, size_t, void*))aReallocFunction,
-		aUserData);
+		aUserData,
+		aSizingMode);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Single pass formatter, each argument is validated and printed straight into the sink so only
+// one print data is ever needed and the format string is only read once.
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+class MSF_SinkFormatter
+{
+public:
+	MSF_SinkFormatter(MSF_StringFormatTemplate<Char> const& aStringFormat, MSF_FormatSink<Char>& aSink)
+		: mySink(aSink)
+		, myString(aStringFormat.GetString())
+		, myRead(aStringFormat.GetString())
+		, myArgs(aStringFormat.GetArgs())
+	{}
+
+	MSF_PrintResult Format(MSF_StringFormatTemplate<Char> const& aStringFormat)
+	{
+		uint32_t const inputCount = aStringFormat.NumArgs();
+		if (inputCount > MSF_MAX_ARGUMENTS)
+			return MSF_PrintResult(ER_TooManyInputs, inputCount, 0);
+
+		// Strings validated at compile time have already been parsed
+		if (aStringFormat.GetLength())
+			return PrintLayout(aStringFormat.GetSpecifiers(), aStringFormat.NumSpecifiers(), aStringFormat.GetLength());
+
+#if MSF_FORMAT_CACHE_SIZE
+		uint32_t const cacheKey = MSF_GetFormatCacheKey<Char>(inputCount);
+
+		uint32_t length;
+		uint64_t const hash = MSF_HashFormatString(myString, length);
+
+		MSF_FormatLayout layout;
+		if (MSF_FormatCache::Find(myString, cacheKey, hash, layout) && layout.myLength == length)
+			return PrintLayout(layout.mySpecifiers, layout.myNumSpecifiers, layout.myLength);
+
+		layout.myNumSpecifiers = 0;
+#endif
+
+		MSF_FormatParser<Char> parser(myString, inputCount);
+		for (;;)
+		{
+			MSF_FormatSpecifier specifier;
+			bool found;
+			MSF_PrintResult result = parser.Next(specifier, found);
+			if (result.HasError())
+				return result;
+			if (!found)
+				break;
+
+			result = PrintSpecifier(specifier);
+			if (result.HasError())
+				return result;
+
+#if MSF_FORMAT_CACHE_SIZE
+			// Too many specifiers will just stop the string from being cached
+			if (layout.myNumSpecifiers < MSF_FORMAT_CACHE_MAX_SPECIFIERS)
+				layout.mySpecifiers[layout.myNumSpecifiers] = specifier;
+			++layout.myNumSpecifiers;
+#endif
+		}
+
+#if MSF_FORMAT_CACHE_SIZE
+		if (layout.myNumSpecifiers <= MSF_FORMAT_CACHE_MAX_SPECIFIERS)
+		{
+			layout.myLength = parser.GetLength();
+			layout.myNumEscapes = parser.GetNumEscapes();
+			MSF_FormatCache::Insert(myString, cacheKey, hash, layout);
+		}
+#endif
+
+		return Finish(parser.GetLength());
+	}
+
+	void ProcessError(MSF_PrintResult anError)
+	{
+		MSF_ErrorMode errorMode = MSF_CustomPrint::GetErrorMode();
+		char errorMessage[256];
+		size_t errorLength = anError.ToString(errorMessage, mySink.myEnd - mySink.myStart);
+
+		if (errorMode == MSF_ErrorMode::Assert)
+		{
+#if MSF_ASSERTS_ENABLED
+			if (!MSF_IsAsserting())
+			{
+				MSF_ASSERT(false, "Error formatting string: %s", errorMessage);
+			}
+#endif
+		}
+		else if (errorMode == MSF_ErrorMode::WriteString)
+		{
+			mySink.Reserve(errorLength + 1);
+			if (mySink.myWrite != mySink.myEnd)
+			{
+				mySink.myWrite += MSF_UTFCopy(mySink.myWrite, mySink.myEnd - mySink.myWrite, errorMessage, errorLength).Elements;
+			}
+		}
+
+		// Null terminate if possible
+		if (mySink.myWrite != mySink.myEnd)
+			*mySink.myWrite = '\0';
+
+		mySink.Finish();
+	}
+
+protected:
+	MSF_PrintResult PrintLayout(MSF_FormatSpecifier const* someSpecifiers, uint32_t aNumSpecifiers, uint32_t aLength)
+	{
+		for (uint32_t i = 0; i < aNumSpecifiers; ++i)
+		{
+			MSF_PrintResult result = PrintSpecifier(someSpecifiers[i]);
+			if (result.HasError())
+				return result;
+		}
+
+		return Finish(aLength);
+	}
+
+	MSF_PrintResult PrintSpecifier(MSF_FormatSpecifier const& aSpecifier)
+	{
+		MSF_PrintResult result = WriteLiteral(myString + aSpecifier.myStart);
+		if (result.HasError())
+			return result;
+
+		MSF_PrintData printData;
+		result = MSF_CustomPrint::BindSpecifier(printData, aSpecifier, myString, myArgs, 0);
+
+		// + 1 since printers are allowed to null terminate. Estimates can be much larger than what is
+		// actually printed so get the exact length before falling back to printing it on the side.
+		bool fits = true;
+		if (!result.HasError() && !mySink.Reserve(printData.myMaxLength + 1))
+		{
+			result = MSF_CustomPrint::BindSpecifier(printData, aSpecifier, myString, myArgs, PRINT_EXACT_LENGTH);
+			fits = result.HasError() || mySink.Reserve(printData.myMaxLength + 1);
+		}
+
+		if (!fits)
+			result = WritePrinted(printData);
+
+		if (result.HasError())
+		{
+			result.Location = aSpecifier.myEnd;
+			return result;
+		}
+
+		if (fits)
+		{
+			mySink.myWrite += MSF_CustomPrint::Print(mySink.myWrite, (Char const*)mySink.myEnd, printData);
+			MSF_ASSERT(mySink.myWrite < mySink.myEnd);
+		}
+
+		myRead = myString + aSpecifier.myEnd;
+		return result;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Copy text up to anEnd, written in pieces if the sink can't make room for all of it at once
+	//-------------------------------------------------------------------------------------------------
+	MSF_PrintResult WriteLiteral(Char const* anEnd)
+	{
+		while (myRead != anEnd)
+		{
+			if (mySink.myWrite == mySink.myEnd)
+			{
+				mySink.Reserve(anEnd - myRead);
+				if (mySink.myWrite == mySink.myEnd)
+					return MSF_PrintResult(ER_NotEnoughSpace, 0, myRead - myString);
+			}
+
+			mySink.myWrite = MSF_CopyLiteral(mySink.myWrite, mySink.myEnd, myRead, anEnd);
+		}
+
+		return MSF_PrintResult(0);
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Copy plain text that isn't part of the format string, written in pieces if needed
+	//-------------------------------------------------------------------------------------------------
+	MSF_PrintResult WriteText(Char const* aText, size_t aLength)
+	{
+		while (aLength)
+		{
+			if (!mySink.Reserve(aLength) && mySink.myWrite == mySink.myEnd)
+				return MSF_PrintResult(ER_NotEnoughSpace);
+
+			size_t const count = MSF_IntMin(aLength, size_t(mySink.myEnd - mySink.myWrite));
+			MSF_CopyChars(mySink.myWrite, mySink.myEnd, aText, count);
+			mySink.myWrite += count;
+			aText += count;
+			aLength -= count;
+		}
+
+		return MSF_PrintResult(0);
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Print an argument the sink can't make room for into a temporary buffer and write it in pieces
+	//-------------------------------------------------------------------------------------------------
+	MSF_PrintResult WritePrinted(MSF_PrintData const& aPrintData)
+	{
+		size_t const length = aPrintData.myMaxLength + 1;
+		Char inlineBuffer[256];
+		Char* buffer = length <= 256 ? inlineBuffer : (Char*)MSF_ALLOCATE(sizeof(Char) * length);
+		if (!buffer)
+			return MSF_PrintResult(ER_PrintAllocationFailed, length);
+
+		size_t const printed = MSF_CustomPrint::Print(buffer, buffer + length, aPrintData);
+		MSF_ASSERT(printed < length);
+
+		MSF_PrintResult result = WriteText(buffer, printed);
+
+		if (buffer != inlineBuffer)
+			MSF_FREE(buffer);
+
+		return result;
+	}
+
+	MSF_PrintResult Finish(uint32_t aLength)
+	{
+		// length includes the null terminator
+		MSF_PrintResult result = WriteLiteral(myString + aLength - 1);
+		if (result.HasError())
+			return result;
+
+		if (!mySink.Reserve(1))
+			return MSF_PrintResult(ER_NotEnoughSpace, 0, aLength);
+
+		*mySink.myWrite = '\0';
+
+		if (!mySink.Finish())
+			return MSF_PrintResult(ER_NotEnoughSpace, 0, aLength);
+
+		return result;
+	}
+
+	MSF_FormatSink<Char>& mySink;
+	Char const* myString;
+	Char const* myRead;
+	MSF_StringFormatType const* myArgs;
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+intptr_t MSF_FormatToSinkShared(MSF_StringFormatTemplate<Char> const& aStringFormat, MSF_FormatSink<Char>& aSink)
+{
+	size_t const startLength = aSink.Length();
+
+	MSF_SinkFormatter<Char> formatter(aStringFormat, aSink);
+	MSF_PrintResult result = formatter.Format(aStringFormat);
+
+	if (result.HasError())
+	{
+		formatter.ProcessError(result);
+		return -1;
+	}
+
+	return aSink.Length() - startLength;
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatToSink(MSF_StringFormat const& aStringFormat, MSF_FormatSink<char>& aSink)
+{
+	return MSF_FormatToSinkShared(aStringFormat, aSink);
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatToSink(MSF_StringFormatUTF8 const& aStringFormat, MSF_FormatSink<char8_t>& aSink)
+{
+	return MSF_FormatToSinkShared(
+		*(MSF_StringFormatTemplate<char> const*)&aStringFormat,
+		*(MSF_FormatSink<char>*)&aSink);
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatToSink(MSF_StringFormatUTF16 const& aStringFormat, MSF_FormatSink<char16_t>& aSink)
+{
+	return MSF_FormatToSinkShared(aStringFormat, aSink);
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatToSink(MSF_StringFormatUTF32 const& aStringFormat, MSF_FormatSink<char32_t>& aSink)
+{
+	return MSF_FormatToSinkShared(aStringFormat, aSink);
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatToSink(MSF_StringFormatWChar const& aStringFormat, MSF_FormatSink<wchar_t>& aSink)
+{
+	return MSF_FormatToSinkShared(
+		*(MSF_StringFormatTemplate<MSF_WChar> const*)&aStringFormat,
+		*(MSF_FormatSink<MSF_WChar>*)&aSink);
+}
+
+//-------------------------------------------------------------------------------------------------
+// String format with a single argument that is replaced by each value of a span in turn
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+class MSF_SpanStringFormat : public MSF_StringFormatTemplate<Char>
+{
+public:
+	MSF_SpanStringFormat(Char const* aString, MSF_StringFormatType const& aType)
+		: MSF_StringFormatTemplate<Char>(aString, 1)
+		, myValue(aType)
+	{}
+
+	MSF_StringFormatType myValue;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Sink formatter that parses the format string once and then prints it for every value of a span
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+class MSF_SpanFormatter : public MSF_SinkFormatter<Char>
+{
+public:
+	MSF_SpanFormatter(MSF_SpanStringFormat<Char>& aStringFormat, MSF_FormatSink<Char>& aSink)
+		: MSF_SinkFormatter<Char>(aStringFormat, aSink)
+		, myValue(aStringFormat.myValue)
+	{}
+
+	MSF_PrintResult Format(MSF_SpanValues const& someValues, Char const* aSeparator)
+	{
+		if (GetValueSize(someValues.myType.myType) != someValues.myStride)
+			return MSF_PrintResult(ER_UnsupportedType, someValues.myType.myType, 0);
+
+		MSF_FormatParser<Char> parser(this->myString, 1);
+		MSF_FormatSpecifier specifier;
+		bool found;
+		MSF_PrintResult result = parser.Next(specifier, found);
+		if (result.HasError())
+			return result;
+		if (!found)
+			return MSF_PrintResult(ER_SpanSpecifierCount, 0, parser.GetLength());
+
+		MSF_FormatSpecifier extra;
+		result = parser.Next(extra, found);
+		if (result.HasError())
+			return result;
+		if (found)
+			return MSF_PrintResult(ER_SpanSpecifierCount, 0, extra.myStart);
+
+		uint32_t const length = parser.GetLength();
+		Char const* const end = this->myString + length - 1;
+		size_t const separatorLength = aSeparator ? MSF_Strlen(aSeparator) : 0;
+
+		char const* value = (char const*)someValues.myValues;
+		for (size_t i = 0; i < someValues.myCount; ++i, value += someValues.myStride)
+		{
+			if (i && separatorLength)
+			{
+				result = this->WriteText(aSeparator, separatorLength);
+				if (result.HasError())
+					return result;
+			}
+
+			// only the bytes of the value change, the type info is the same for every value
+			memcpy(&myValue.myValue64, value, someValues.myStride);
+
+			this->myRead = this->myString;
+			result = this->PrintSpecifier(specifier);
+			if (result.HasError())
+				return result;
+
+			result = this->WriteLiteral(end);
+			if (result.HasError())
+				return result;
+		}
+
+		// literal text has been written with each value
+		this->myRead = end;
+		return this->Finish(length);
+	}
+
+private:
+	static size_t GetValueSize(uint64_t aType)
+	{
+		switch (aType)
+		{
+		case MSF_StringFormatType::Type8: return 1;
+		case MSF_StringFormatType::Type16: return 2;
+		case MSF_StringFormatType::Type32: return 4;
+		case MSF_StringFormatType::Type64: return 8;
+		case MSF_StringFormatType::Typefloat: return sizeof(float);
+		case MSF_StringFormatType::Typedouble: return sizeof(double);
+		}
+		return 0;
+	}
+
+	MSF_StringFormatType& myValue;
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+intptr_t MSF_FormatSpanShared(MSF_FormatSink<Char>& aSink, Char const* aFormat, MSF_SpanValues const& someValues, Char const* aSeparator)
+{
+	size_t const startLength = aSink.Length();
+
+	MSF_SpanStringFormat<Char> stringFormat(aFormat, someValues.myType);
+	MSF_SpanFormatter<Char> formatter(stringFormat, aSink);
+	MSF_PrintResult result = formatter.Format(someValues, aSeparator);
+
+	if (result.HasError())
+	{
+		formatter.ProcessError(result);
+		return -1;
+	}
+
+	return aSink.Length() - startLength;
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatSpan(MSF_FormatSink<char>& aSink, char const* aFormat, MSF_SpanValues const& someValues, char const* aSeparator)
+{
+	return MSF_FormatSpanShared(aSink, aFormat, someValues, aSeparator);
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatSpan(MSF_FormatSink<char8_t>& aSink, char8_t const* aFormat, MSF_SpanValues const& someValues, char8_t const* aSeparator)
+{
+	return MSF_FormatSpanShared(*(MSF_FormatSink<char>*)&aSink, (char const*)aFormat, someValues, (char const*)aSeparator);
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatSpan(MSF_FormatSink<char16_t>& aSink, char16_t const* aFormat, MSF_SpanValues const& someValues, char16_t const* aSeparator)
+{
+	return MSF_FormatSpanShared(aSink, aFormat, someValues, aSeparator);
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatSpan(MSF_FormatSink<char32_t>& aSink, char32_t const* aFormat, MSF_SpanValues const& someValues, char32_t const* aSeparator)
+{
+	return MSF_FormatSpanShared(aSink, aFormat, someValues, aSeparator);
+}
+//-------------------------------------------------------------------------------------------------
+intptr_t MSF_FormatSpan(MSF_FormatSink<wchar_t>& aSink, wchar_t const* aFormat, MSF_SpanValues const& someValues, wchar_t const* aSeparator)
+{
+	return MSF_FormatSpanShared(*(MSF_FormatSink<MSF_WChar>*)&aSink, (MSF_WChar const*)aFormat, someValues, (MSF_WChar const*)aSeparator);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1078,8 +1855,8 @@ template <typename Char>
 class MSF_StringFormatCopier : public MSF_StringFormatTemplate<Char>
 {
 public:
-	MSF_StringFormatCopier(Char const* aString, uint32_t aCount)
-		: MSF_StringFormatTemplate<Char>(aString, aCount)
+	MSF_StringFormatCopier(Char const* aString, uint32_t aCount, uint32_t aLength, uint32_t aNumSpecifiers, uint32_t aNumEscapes)
+		: MSF_StringFormatTemplate<Char>(aString, aCount, aLength, aNumSpecifiers, aNumEscapes)
 	{}
 
 	template <typename Alloc>
@@ -1087,16 +1864,29 @@ public:
 	{
 		MSF_StringFormatType const* sourceArgs = aStringFormat.GetArgs();
 		uint32_t const nargs = aStringFormat.NumArgs();
-
-		size_t const baseLength = sizeof(MSF_StringFormatTemplate<Char>) + sizeof(MSF_StringFormatType) * nargs;
-
-		size_t argSizes[MSF_MAX_ARGUMENTS];
+		uint32_t nspecifiers = aStringFormat.NumSpecifiers();
+		uint32_t nescapes = aStringFormat.NumEscapes();
+		uint32_t length = aStringFormat.GetLength();
+
+		// Runtime strings are parsed once here when the copy owns its format string, so it's printed the same
+		// way as a validated string and never needs the format cache. Strings that fail to parse are left for
+		// printing to report the error.
+		bool const parse = !length && anIncludeFormatString;
+		if (parse)
+			length = Parse(aStringFormat.GetString(), nargs, nullptr, nspecifiers, nescapes);
+
+		size_t const specifiersLength = sizeof(MSF_FormatSpecifier) * nspecifiers;
+		size_t const baseLength = sizeof(MSF_StringFormatTemplate<Char>) + sizeof(MSF_StringFormatType) * nargs + specifiersLength;
+
+		// sizes of the first few arguments are kept, any after that are rare enough to just work out again
+		size_t argSizes[MSF_INLINE_ARGUMENTS];
 		size_t argsTotalLength = 0;
 		for (uint32_t arg = 0; arg < nargs; ++arg)
 		{
-			argSizes[arg] = MSF_CustomPrint::GetTypeCopyLength(sourceArgs[arg]);
-			argSizes[arg] = (argSizes[arg] + (MSF_COPY_ALIGNMENT - 1)) & (~(MSF_COPY_ALIGNMENT - 1));
-			argsTotalLength += argSizes[arg];
+			size_t const argSize = MSF_CustomPrint::GetTypeCopyLength(sourceArgs[arg]);
+			if (arg < MSF_INLINE_ARGUMENTS)
+				argSizes[arg] = argSize;
+			argsTotalLength += AlignCopyLength(argSize);
 		}
 
 		size_t const formatLength = (anIncludeFormatString ? MSF_Strlen(aStringFormat.GetString()) + 1 : 0) * sizeof(Char);
@@ -1110,24 +1900,30 @@ public:
 
 			if (anIncludeFormatString)
 			{
-				new (stringFormatCopy) MSF_StringFormatCopier((Char const*)data, nargs);
+				new (stringFormatCopy) MSF_StringFormatCopier((Char const*)data, nargs, length, nspecifiers, nescapes);
 				MSF_CopyChars(data, data + formatLength, (char const*)aStringFormat.GetString(), formatLength);
 				data += formatLength;
 			}
 			else
-				new (stringFormatCopy) MSF_StringFormatCopier(aStringFormat.GetString(), nargs);
+				new (stringFormatCopy) MSF_StringFormatCopier(aStringFormat.GetString(), nargs, length, nspecifiers, nescapes);
+
+			// compile time parsed specifiers are still valid since they are relative to the format string
+			if (parse && length)
+				Parse(aStringFormat.GetString(), nargs, (MSF_FormatSpecifier*)stringFormatCopy->GetSpecifiers(), nspecifiers, nescapes);
+			else if (specifiersLength)
+				MSF_CopyChars((char*)stringFormatCopy->GetSpecifiers(), (char*)data, (char const*)aStringFormat.GetSpecifiers(), specifiersLength);
 
 			for (uint32_t arg = 0; arg < nargs; ++arg)
 			{
 				MSF_StringFormatType const& sourceArg = sourceArgs[arg];
 				MSF_StringFormatType& destArg = destArgs[arg];
-				size_t const argSize = argSizes[arg];
+				size_t const argSize = arg < MSF_INLINE_ARGUMENTS ? argSizes[arg] : MSF_CustomPrint::GetTypeCopyLength(sourceArg);
 
 				if (argSize)
 				{
 					destArg.myString = data;
-					MSF_CopyChars(data, data + argSizes[arg], sourceArg.myString, argSize);
-					data += argSizes[arg];
+					MSF_CopyChars(data, data + argSize, sourceArg.myString, argSize);
+					data += AlignCopyLength(argSize);
 				}
 				else
 					destArg.myValue64 = sourceArg.myValue64;
@@ -1140,6 +1936,36 @@ public:
 		}
 		return stringFormatCopy;
 	}
+
+private:
+	// Returns the parsed length, or 0 if the string has an error. Only counts when someSpecifiersOut is null.
+	static uint32_t Parse(Char const* aString, uint32_t aNumArgs, MSF_FormatSpecifier* someSpecifiersOut, uint32_t& aNumSpecifiersOut, uint32_t& aNumEscapesOut)
+	{
+		MSF_FormatParser<Char> parser(aString, aNumArgs);
+		uint32_t count = 0;
+		for (;;)
+		{
+			MSF_FormatSpecifier specifier;
+			bool found;
+			if (parser.Next(specifier, found).HasError())
+				return 0;
+			if (!found)
+				break;
+
+			if (someSpecifiersOut)
+				someSpecifiersOut[count] = specifier;
+			++count;
+		}
+
+		aNumSpecifiersOut = count;
+		aNumEscapesOut = parser.GetNumEscapes();
+		return parser.GetLength();
+	}
+
+	static size_t AlignCopyLength(size_t aLength)
+	{
+		return (aLength + (MSF_COPY_ALIGNMENT - 1)) & (~(MSF_COPY_ALIGNMENT - 1));
+	}
 };
 //-------------------------------------------------------------------------------------------------
 MSF_StringFormat const* MSF_CopyStringFormat(MSF_StringFormat const& aStringFormat, void* (*anAlloc)(size_t), bool anIncludeFormatString)
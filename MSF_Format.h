@@ -23,6 +23,8 @@ public:
         Typedouble	= (1 << 6),
 		// END DO NOT MOVE
 
+		Type128		= (1 << 7), // too big for the value union, referenced by pointer like user types
+
 		TypeUserIndex = 8, // first user type, can go up to number of bits in uint32_t
 		TypeUser	= (1 << TypeUserIndex), 
     };
@@ -48,6 +50,11 @@ public:
     explicit constexpr MSF_StringFormatType(double aData) : mydouble(aData), myType(Typedouble), myUserData(0) {}
 	explicit constexpr MSF_StringFormatType(long double aData) : mydouble((double)aData), myType(Typedouble), myUserData(0) {}
 
+#if MSF_USE_INT128
+	explicit constexpr MSF_StringFormatType(MSF_Int128 const& aData) : myUserType(&aData), myType(Type128), myUserData(Signed) {}
+	explicit constexpr MSF_StringFormatType(MSF_UInt128 const& aData) : myUserType(&aData), myType(Type128), myUserData(0) {}
+#endif
+
 	explicit constexpr MSF_StringFormatType(char aData) : myValue32(aData), myType(Type8), myUserData(Signed | Char) {}
 	explicit constexpr MSF_StringFormatType(char const* aData) : myString(aData), myType(TypeString), myUserData(0) {}
 
@@ -120,20 +127,26 @@ MSF_MAP_CHAR_TO_TYPES('c', MSF_StringFormatType::Type8 | MSF_StringFormatType::T
 MSF_MAP_CHAR_TO_TYPES('C', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
 MSF_MAP_CHAR_TO_TYPES('s', MSF_StringFormatType::TypeString);
 MSF_MAP_CHAR_TO_TYPES('S', MSF_StringFormatType::TypeString);
-MSF_MAP_CHAR_TO_TYPES('d', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
-MSF_MAP_CHAR_TO_TYPES('i', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
-MSF_MAP_CHAR_TO_TYPES('u', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
-MSF_MAP_CHAR_TO_TYPES('o', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
-MSF_MAP_CHAR_TO_TYPES('x', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
-MSF_MAP_CHAR_TO_TYPES('X', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
+MSF_MAP_CHAR_TO_TYPES('d', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128);
+MSF_MAP_CHAR_TO_TYPES('i', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128);
+MSF_MAP_CHAR_TO_TYPES('u', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128);
+MSF_MAP_CHAR_TO_TYPES('o', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128);
+MSF_MAP_CHAR_TO_TYPES('x', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128);
+MSF_MAP_CHAR_TO_TYPES('X', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128);
 MSF_MAP_CHAR_TO_TYPES('p', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
 MSF_MAP_CHAR_TO_TYPES('P', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64);
+MSF_MAP_CHAR_TO_TYPES('b', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128);
+MSF_MAP_CHAR_TO_TYPES('B', MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128);
 MSF_MAP_CHAR_TO_TYPES('e', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
 MSF_MAP_CHAR_TO_TYPES('E', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
 MSF_MAP_CHAR_TO_TYPES('f', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
 MSF_MAP_CHAR_TO_TYPES('F', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
 MSF_MAP_CHAR_TO_TYPES('g', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
 MSF_MAP_CHAR_TO_TYPES('G', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
+MSF_MAP_CHAR_TO_TYPES('r', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
+MSF_MAP_CHAR_TO_TYPES('R', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
+MSF_MAP_CHAR_TO_TYPES('a', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
+MSF_MAP_CHAR_TO_TYPES('A', MSF_StringFormatType::Typefloat | MSF_StringFormatType::Typedouble);
 
 //-------------------------------------------------------------------------------------------------
 // For types that don't auto convert to a known type you can use this macro to define a conversion
@@ -239,6 +252,52 @@ MSF_DEFINE_USER_INT_TYPE(unsigned long);
 MSF_DEFINE_USER_INT_TYPE(long long);
 MSF_DEFINE_USER_INT_TYPE(unsigned long long);
 
+//-------------------------------------------------------------------------------------------------
+// Flags that affect print output (only available on some functions)
+// See standards for more details:
+// Microsoft: http://msdn.microsoft.com/en-us/library/56e442dc.aspx
+// STD: https://en.cppreference.com/w/c/io/fprintf
+//-------------------------------------------------------------------------------------------------
+enum MSF_PrintFlags
+{
+	PRINT_PREFIX = 0x01,		// '#' Only show decimal point if digits follow, truncate trailing zeros
+	PRINT_SIGN = 0x02,			// '+' show + sign when positive
+	PRINT_BLANK = 0x04,			// ' ' prefix with spaces / show space when positive
+	PRINT_LEFTALIGN = 0x08,		// '-' invalidates the zero option
+	PRINT_ZERO = 0x10,			// '0' prefix with zeros
+	PRINT_PRECISION = 0x20,		// '.' notifies that precision was specified
+	PRINT_EXACT_LENGTH = 0x40,	// not a format flag, validation must return the exact length that will be printed
+};
+
+//-------------------------------------------------------------------------------------------------
+// Wildcard arguments used by a print specifier. Wildcard arguments are always directly before the
+// argument being printed, width first then precision.
+//-------------------------------------------------------------------------------------------------
+enum MSF_FormatWildcards
+{
+	WILDCARD_WIDTH = 0x01,		// '*' width is read from an argument
+	WILDCARD_PRECISION = 0x02,	// '.*' precision is read from an argument
+};
+
+//-------------------------------------------------------------------------------------------------
+// Everything about a print specifier that can be determined from the format string alone.
+// Offsets are relative to the start of the format string.
+//-------------------------------------------------------------------------------------------------
+struct MSF_FormatSpecifier
+{
+	uint32_t myStart; // offset of the opening '%' or '{'
+	uint32_t myEnd; // offset one past the end of the specifier
+
+	uint16_t myWidth;
+	uint16_t myPrecision;
+
+	uint8_t myFlags; // see MSF_PrintFlags
+	uint8_t myWildcards; // see MSF_FormatWildcards
+	uint8_t myArgument; // index of the argument to print
+
+	char myPrintChar; // 0 to use the default print character of the argument type
+};
+
 //-------------------------------------------------------------------------------------------------
 // Normally we want to take by reference to reduce unneeded copies (inliner should more or less make it moot anyway)
 // However if this code is used with c++cli it doesn't want c++ code to take cli code by reference so
@@ -263,14 +322,26 @@ public:
 	MSF_StringFormatType const* GetArgs() const { return (MSF_StringFormatType const* )(this + 1); }
 	uint32_t NumArgs() const { return myNumArgs; }
 
+	// Specifiers are only available if the string was parsed at compile time or copied along with its format string, in which case the length will be non-zero
+	MSF_FormatSpecifier const* GetSpecifiers() const { return (MSF_FormatSpecifier const*)(GetArgs() + myNumArgs); }
+	uint32_t NumSpecifiers() const { return myNumSpecifiers; }
+	uint32_t NumEscapes() const { return myNumEscapes; } // doubled control characters, i.e. "%%"
+	uint32_t GetLength() const { return myLength; }
+
 protected:
-	MSF_StringFormatTemplate(Char const* aString, uint32_t aCount)
+	MSF_StringFormatTemplate(Char const* aString, uint32_t aCount, uint32_t aLength = 0, uint32_t aNumSpecifiers = 0, uint32_t aNumEscapes = 0)
 		: myString(aString)
 		, myNumArgs(aCount)
+		, myLength(aLength)
+		, myNumSpecifiers(aNumSpecifiers)
+		, myNumEscapes(aNumEscapes)
 	{}
 
 	Char const* myString;
 	uint32_t myNumArgs;
+	uint32_t myLength;
+	uint32_t myNumSpecifiers;
+	uint32_t myNumEscapes;
 };
 
 extern template class MSF_StringFormatTemplate<char>;
@@ -285,8 +356,14 @@ typedef MSF_StringFormatTemplate<char16_t> MSF_StringFormatUTF16;
 typedef MSF_StringFormatTemplate<char32_t> MSF_StringFormatUTF32;
 typedef MSF_StringFormatTemplate<wchar_t> MSF_StringFormatWChar;
 
+#if defined(MSF_VALIDATION_ENABLED)
+template <typename Type> struct MSF_TypeWrapper;
+template <typename Char, typename... Args> struct MSF_Validator;
+#endif
+
 //-------------------------------------------------------------------------------------------------
-// Holds all the arguments for a printable string
+// Holds all the arguments for a printable string. When constructed from a validated string the
+// specifiers parsed at compile time are stored directly after the arguments.
 //-------------------------------------------------------------------------------------------------
 template<typename Char, typename ...Args>
 class MSF_StringFormatContainer : public MSF_StringFormatTemplate<Char>
@@ -298,8 +375,19 @@ public:
 	{
 	}
 
+#if defined(MSF_VALIDATION_ENABLED)
+	MSF_StringFormatContainer(MSF_STRING(Char) const& aString, ARGS args)
+		: MSF_StringFormatTemplate<Char>(aString.myString, sizeof...(Args), aString.myLength, aString.myNumSpecifiers, aString.myNumEscapes)
+		, myArgs { typename MSF_StringFormatTypeLookup<Args>::Format(args)... }
+	{
+		for (uint32_t i = 0; i < aString.myNumSpecifiers; ++i)
+			mySpecifiers[i] = aString.mySpecifiers[i];
+	}
+#endif
+
 private:
 	MSF_StringFormatType myArgs[sizeof...(Args)];
+	MSF_VALIDATION_ONLY(MSF_FormatSpecifier mySpecifiers[sizeof...(Args)];)
 };
 
 template<typename Char>
@@ -310,16 +398,32 @@ public:
 		: MSF_StringFormatTemplate<Char>(aString, 0)
 	{
 	}
+
+#if defined(MSF_VALIDATION_ENABLED)
+	MSF_StringFormatContainer(MSF_Validator<Char> const& aString)
+		: MSF_StringFormatTemplate<Char>(aString.myString, 0, aString.myLength, 0, aString.myNumEscapes)
+	{
+	}
+#endif
 };
+//-------------------------------------------------------------------------------------------------
+// Control how the required buffer length is calculated before printing
+//-------------------------------------------------------------------------------------------------
+enum class MSF_SizingMode
+{
+	Estimate,	// Fast upper bound, reallocated buffers will usually be larger than what's printed
+	Exact,		// Built in types calculate exactly what will be printed, costs an extra pass for floats
+};
+
 //-------------------------------------------------------------------------------------------------
 // Start of typesafe printf, this part generates the data that holds references to the inputs
 // These do not use templates for the char type since we only support char and char16_t
 //-------------------------------------------------------------------------------------------------
-extern intptr_t MSF_FormatString(MSF_StringFormat const& aStringFormat, char* aBuffer, size_t aBufferLength, size_t anOffset = 0, char* (*aReallocFunction)(char*, size_t, void*) = nullptr, void* aUserData = nullptr);
-extern intptr_t MSF_FormatString(MSF_StringFormatUTF8 const& aStringFormat, char8_t* aBuffer, size_t aBufferLength, size_t anOffset = 0, char8_t* (*aReallocFunction)(char8_t*, size_t, void*) = nullptr, void* aUserData = nullptr);
-extern intptr_t MSF_FormatString(MSF_StringFormatUTF16 const& aStringFormat, char16_t* aBuffer, size_t aBufferLength, size_t anOffset = 0, char16_t* (*aReallocFunction)(char16_t*, size_t, void*) = nullptr, void* aUserData = nullptr);
-extern intptr_t MSF_FormatString(MSF_StringFormatUTF32 const& aStringFormat, char32_t* aBuffer, size_t aBufferLength, size_t anOffset = 0, char32_t* (*aReallocFunction)(char32_t*, size_t, void*) = nullptr, void* aUserData = nullptr);
-extern intptr_t MSF_FormatString(MSF_StringFormatWChar const& aStringFormat, wchar_t* aBuffer, size_t aBufferLength, size_t anOffset = 0, wchar_t* (*aReallocFunction)(wchar_t*, size_t, void*) = nullptr, void* aUserData = nullptr);
+extern intptr_t MSF_FormatString(MSF_StringFormat const& aStringFormat, char* aBuffer, size_t aBufferLength, size_t anOffset = 0, char* (*aReallocFunction)(char*, size_t, void*) = nullptr, void* aUserData = nullptr, MSF_SizingMode aSizingMode = MSF_SizingMode::Estimate);
+extern intptr_t MSF_FormatString(MSF_StringFormatUTF8 const& aStringFormat, char8_t* aBuffer, size_t aBufferLength, size_t anOffset = 0, char8_t* (*aReallocFunction)(char8_t*, size_t, void*) = nullptr, void* aUserData = nullptr, MSF_SizingMode aSizingMode = MSF_SizingMode::Estimate);
+extern intptr_t MSF_FormatString(MSF_StringFormatUTF16 const& aStringFormat, char16_t* aBuffer, size_t aBufferLength, size_t anOffset = 0, char16_t* (*aReallocFunction)(char16_t*, size_t, void*) = nullptr, void* aUserData = nullptr, MSF_SizingMode aSizingMode = MSF_SizingMode::Estimate);
+extern intptr_t MSF_FormatString(MSF_StringFormatUTF32 const& aStringFormat, char32_t* aBuffer, size_t aBufferLength, size_t anOffset = 0, char32_t* (*aReallocFunction)(char32_t*, size_t, void*) = nullptr, void* aUserData = nullptr, MSF_SizingMode aSizingMode = MSF_SizingMode::Estimate);
+extern intptr_t MSF_FormatString(MSF_StringFormatWChar const& aStringFormat, wchar_t* aBuffer, size_t aBufferLength, size_t anOffset = 0, wchar_t* (*aReallocFunction)(wchar_t*, size_t, void*) = nullptr, void* aUserData = nullptr, MSF_SizingMode aSizingMode = MSF_SizingMode::Estimate);
 
 //-------------------------------------------------------------------------------------------------
 // Include validation code as late as possible since there's lots of weird dependencies
@@ -376,6 +480,7 @@ intptr_t MSF_Format(wchar_t* aBuffer, size_t aSize, MSF_STRING(wchar_t) aString,
 
 //-------------------------------------------------------------------------------------------------
 // Make a backup copy of string format structure. This will request an allocation to hold all relevant data.
+// Copies that include the format string also keep it parsed, so printing them never parses it again.
 //-------------------------------------------------------------------------------------------------
 extern MSF_StringFormat const* MSF_CopyStringFormat(MSF_StringFormat const& aStringFormat, void* (*anAlloc)(size_t), bool anIncludeFormatString = true);
 extern MSF_StringFormatUTF8 const* MSF_CopyStringFormat(MSF_StringFormatUTF8 const& aStringFormat, void* (*anAlloc)(size_t), bool anIncludeFormatString = true);
@@ -0,0 +1,244 @@
+#include "MSF_FormatCache.h"
+#include "MSF_Assert.h"
+#include <atomic>
+#include <string.h>
+
+#if MSF_FORMAT_CACHE_SIZE
+
+static_assert((MSF_FORMAT_CACHE_SIZE & (MSF_FORMAT_CACHE_SIZE - 1)) == 0 && MSF_FORMAT_CACHE_SIZE >= 2, "MSF_FORMAT_CACHE_SIZE must be a power of 2");
+static_assert(sizeof(MSF_FormatSpecifier) == 16, "sizeof MSF_FormatSpecifier changed, update code");
+static_assert(sizeof(MSF_FormatLayout) % sizeof(uint64_t) == 0, "MSF_FormatLayout must be stored as whole words");
+static_assert(offsetof(MSF_FormatLayout, mySpecifiers) % sizeof(uint64_t) == 0, "MSF_FormatLayout header must be stored as whole words");
+
+namespace MSF_FormatCache
+{
+	//-------------------------------------------------------------------------------------------------
+	// Each entry is guarded by a sequence number which is odd while the entry is being written.
+	// Readers copy the layout out and then check the sequence is unchanged to know the copy is intact.
+	// The layout is stored as atomic words so torn reads are well defined, just discarded.
+	//-------------------------------------------------------------------------------------------------
+	static constexpr uint32_t theLayoutWords = sizeof(MSF_FormatLayout) / sizeof(uint64_t);
+	static constexpr uint32_t theHeaderWords = offsetof(MSF_FormatLayout, mySpecifiers) / sizeof(uint64_t);
+	static constexpr uint32_t theSpecifierWords = sizeof(MSF_FormatSpecifier) / sizeof(uint64_t);
+	static constexpr uint32_t theNumSets = MSF_FORMAT_CACHE_SIZE / 2;
+
+	struct Entry
+	{
+		std::atomic<uint32_t> mySequence;
+		std::atomic<uint32_t> myUsed;
+		std::atomic<uint32_t> myKey;
+		std::atomic<void const*> myString;
+		std::atomic<uint64_t> myHash;
+		std::atomic<uint64_t> myLayout[theLayoutWords];
+	};
+
+	static Entry theEntries[MSF_FORMAT_CACHE_SIZE];
+
+	static std::atomic<uint64_t> theHits;
+	static std::atomic<uint64_t> theMisses;
+	static std::atomic<uint64_t> theInserts;
+	static std::atomic<uint64_t> theEvictions;
+
+	//-------------------------------------------------------------------------------------------------
+	static Entry* GetSet(void const* aString, uint32_t aKey)
+	{
+		uint64_t hash = ((uint64_t)(uintptr_t)aString ^ aKey) * 0x9E3779B97F4A7C15ull;
+		return theEntries + (uint32_t)(hash >> 32) % theNumSets * 2;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Number of words actually used by a layout, unused specifiers are never copied
+	//-------------------------------------------------------------------------------------------------
+	static uint32_t GetUsedWords(uint64_t aHeader)
+	{
+		MSF_FormatLayout header;
+		memcpy(&header, &aHeader, sizeof(aHeader));
+		uint32_t const numSpecifiers = header.myNumSpecifiers < MSF_FORMAT_CACHE_MAX_SPECIFIERS ? header.myNumSpecifiers : MSF_FORMAT_CACHE_MAX_SPECIFIERS;
+		return theHeaderWords + numSpecifiers * theSpecifierWords;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	static bool TryRead(Entry& anEntry, void const* aString, uint32_t aKey, uint64_t aHash, MSF_FormatLayout& aLayoutOut)
+	{
+		uint32_t const sequence = anEntry.mySequence.load(std::memory_order_acquire);
+		if (sequence & 1)
+			return false;
+
+		if (anEntry.myString.load(std::memory_order_relaxed) != aString || anEntry.myKey.load(std::memory_order_relaxed) != aKey ||
+			anEntry.myHash.load(std::memory_order_relaxed) != aHash)
+			return false;
+
+		uint64_t words[theLayoutWords];
+		words[0] = anEntry.myLayout[0].load(std::memory_order_relaxed);
+		uint32_t const usedWords = GetUsedWords(words[0]);
+		for (uint32_t i = 1; i < usedWords; ++i)
+			words[i] = anEntry.myLayout[i].load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (anEntry.mySequence.load(std::memory_order_relaxed) != sequence)
+			return false;
+
+		memcpy(&aLayoutOut, words, usedWords * sizeof(uint64_t));
+
+		if (!anEntry.myUsed.load(std::memory_order_relaxed))
+			anEntry.myUsed.store(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// Writers never wait, if another thread is already writing the entry we just skip it
+	//-------------------------------------------------------------------------------------------------
+	static bool BeginWrite(Entry& anEntry, uint32_t& aSequenceOut)
+	{
+		aSequenceOut = anEntry.mySequence.load(std::memory_order_relaxed);
+		if ((aSequenceOut & 1) || !anEntry.mySequence.compare_exchange_strong(aSequenceOut, aSequenceOut + 1, std::memory_order_acquire))
+			return false;
+
+		std::atomic_thread_fence(std::memory_order_release);
+		return true;
+	}
+	static void EndWrite(Entry& anEntry, uint32_t aSequence)
+	{
+		anEntry.mySequence.store(aSequence + 2, std::memory_order_release);
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	static void Write(Entry& anEntry, uint32_t aSequence, void const* aString, uint32_t aKey, uint64_t aHash, MSF_FormatLayout const& aLayout)
+	{
+		uint64_t words[theLayoutWords];
+		memcpy(words, &aLayout, sizeof(words));
+		uint32_t const usedWords = GetUsedWords(words[0]);
+
+		anEntry.myString.store(aString, std::memory_order_relaxed);
+		anEntry.myKey.store(aKey, std::memory_order_relaxed);
+		anEntry.myHash.store(aHash, std::memory_order_relaxed);
+		anEntry.myUsed.store(0, std::memory_order_relaxed);
+		for (uint32_t i = 0; i < usedWords; ++i)
+			anEntry.myLayout[i].store(words[i], std::memory_order_relaxed);
+
+		EndWrite(anEntry, aSequence);
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	bool Find(void const* aString, uint32_t aKey, uint64_t aHash, MSF_FormatLayout& aLayoutOut)
+	{
+		Entry* set = GetSet(aString, aKey);
+		if (TryRead(set[0], aString, aKey, aHash, aLayoutOut) || TryRead(set[1], aString, aKey, aHash, aLayoutOut))
+		{
+			theHits.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		theMisses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	void Insert(void const* aString, uint32_t aKey, uint64_t aHash, MSF_FormatLayout const& aLayout)
+	{
+		MSF_ASSERT(aString && aLayout.myNumSpecifiers <= MSF_FORMAT_CACHE_MAX_SPECIFIERS);
+
+		Entry* set = GetSet(aString, aKey);
+
+		// Another thread might have beaten us to it, an entry for the same address with a different hash
+		// is for a string that used to be there and gets replaced
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			if (set[i].myString.load(std::memory_order_relaxed) == aString && set[i].myKey.load(std::memory_order_relaxed) == aKey)
+			{
+				if (set[i].myHash.load(std::memory_order_relaxed) == aHash)
+					return;
+
+				uint32_t sequence;
+				if (BeginWrite(set[i], sequence))
+				{
+					Write(set[i], sequence, aString, aKey, aHash, aLayout);
+					theInserts.fetch_add(1, std::memory_order_relaxed);
+					theEvictions.fetch_add(1, std::memory_order_relaxed);
+				}
+				return;
+			}
+		}
+
+		// Prefer empty entries, then ones that haven't been used since the last eviction in this set
+		Entry* entry = nullptr;
+		bool evicting = false;
+		if (!set[0].myString.load(std::memory_order_relaxed))
+			entry = &set[0];
+		else if (!set[1].myString.load(std::memory_order_relaxed))
+			entry = &set[1];
+		else
+		{
+			evicting = true;
+
+			if (!set[0].myUsed.load(std::memory_order_relaxed))
+				entry = &set[0];
+			else if (!set[1].myUsed.load(std::memory_order_relaxed))
+				entry = &set[1];
+			else
+			{
+				set[1].myUsed.store(0, std::memory_order_relaxed);
+				entry = &set[0];
+			}
+		}
+
+		uint32_t sequence;
+		if (!BeginWrite(*entry, sequence))
+			return;
+
+		Write(*entry, sequence, aString, aKey, aHash, aLayout);
+
+		theInserts.fetch_add(1, std::memory_order_relaxed);
+		if (evicting)
+			theEvictions.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		for (Entry& entry : theEntries)
+		{
+			uint32_t sequence;
+			while (!BeginWrite(entry, sequence)) {}
+
+			entry.myString.store(nullptr, std::memory_order_relaxed);
+			entry.myKey.store(0, std::memory_order_relaxed);
+			entry.myHash.store(0, std::memory_order_relaxed);
+			entry.myUsed.store(0, std::memory_order_relaxed);
+
+			EndWrite(entry, sequence);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	MSF_FormatCacheStats GetStats()
+	{
+		MSF_FormatCacheStats stats;
+		stats.myHits = theHits.load(std::memory_order_relaxed);
+		stats.myMisses = theMisses.load(std::memory_order_relaxed);
+		stats.myInserts = theInserts.load(std::memory_order_relaxed);
+		stats.myEvictions = theEvictions.load(std::memory_order_relaxed);
+		return stats;
+	}
+	void ResetStats()
+	{
+		theHits.store(0, std::memory_order_relaxed);
+		theMisses.store(0, std::memory_order_relaxed);
+		theInserts.store(0, std::memory_order_relaxed);
+		theEvictions.store(0, std::memory_order_relaxed);
+	}
+}
+
+#else // MSF_FORMAT_CACHE_SIZE
+
+namespace MSF_FormatCache
+{
+	bool Find(void const*, uint32_t, uint64_t, MSF_FormatLayout&) { return false; }
+	void Insert(void const*, uint32_t, uint64_t, MSF_FormatLayout const&) {}
+	void Clear() {}
+	MSF_FormatCacheStats GetStats() { return MSF_FormatCacheStats{}; }
+	void ResetStats() {}
+}
+
+#endif // MSF_FORMAT_CACHE_SIZE
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "MSF_Format.h"
+
+//-------------------------------------------------------------------------------------------------
+// Parsed format string, holds all the specifiers found in order
+//-------------------------------------------------------------------------------------------------
+struct MSF_FormatLayout
+{
+	uint32_t myLength; // length of the format string including the null terminator
+	uint32_t myNumSpecifiers;
+	uint32_t myNumEscapes; // doubled control characters in the literal text
+
+	// the cache stores layouts as whole words
+	alignas(uint64_t) MSF_FormatSpecifier mySpecifiers[MSF_FORMAT_CACHE_MAX_SPECIFIERS];
+};
+
+//-------------------------------------------------------------------------------------------------
+// Cache usage information, counters are only updated when the cache is enabled
+//-------------------------------------------------------------------------------------------------
+struct MSF_FormatCacheStats
+{
+	uint64_t myHits;
+	uint64_t myMisses;
+	uint64_t myInserts;
+	uint64_t myEvictions;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Cache of parsed format strings, see MSF_FORMAT_CACHE_SIZE. Entries are stored in sets of two
+// and when both are in use the least recently used is replaced. Lookups never lock, if an entry
+// is being replaced at the same time it is simply treated as a miss.
+//-------------------------------------------------------------------------------------------------
+namespace MSF_FormatCache
+{
+	//-------------------------------------------------------------------------------------------------
+	// Find the layout of a format string, the key must contain everything that could affect parsing.
+	// Strings are found by address and must also match aHash, a hash of the whole string, so memory
+	// that is reused for a different format string never matches the old layout.
+	//-------------------------------------------------------------------------------------------------
+	bool Find(void const* aString, uint32_t aKey, uint64_t aHash, MSF_FormatLayout& aLayoutOut);
+	void Insert(void const* aString, uint32_t aKey, uint64_t aHash, MSF_FormatLayout const& aLayout);
+
+	//-------------------------------------------------------------------------------------------------
+	// Remove all entries
+	//-------------------------------------------------------------------------------------------------
+	void Clear();
+
+	MSF_FormatCacheStats GetStats();
+	void ResetStats();
+}
@@ -2,22 +2,6 @@
 
 #include "MSF_Format.h"
 
-//-------------------------------------------------------------------------------------------------
-// Flags that affect print output (only available on some functions)
-// See standards for more details:
-// Microsoft: http://msdn.microsoft.com/en-us/library/56e442dc.aspx
-// STD: https://en.cppreference.com/w/c/io/fprintf
-//-------------------------------------------------------------------------------------------------
-enum MSF_PrintFlags
-{
-	PRINT_PREFIX = 0x01,		// '#' Only show decimal point if digits follow, truncate trailing zeros
-	PRINT_SIGN = 0x02,			// '+' show + sign when positive
-	PRINT_BLANK = 0x04,			// ' ' prefix with spaces / show space when positive
-	PRINT_LEFTALIGN = 0x08,		// '-' invalidates the zero option
-	PRINT_ZERO = 0x10,			// '0' prefix with zeros
-	PRINT_PRECISION = 0x20,		// '.' notifies that precision was specified
-};
-
 //-------------------------------------------------------------------------------------------------
 // Control the action taken when an error occurs
 //-------------------------------------------------------------------------------------------------
@@ -49,7 +33,7 @@ struct MSF_PrintData
 	void const* myEnd; // end of the %<type> statement, not set in initial func call
 
 	// to be written to in read mode
-	size_t myMaxLength; // max length required, can be an estimate but must never be too low.
+	size_t myMaxLength; // max length required, can be an estimate but must never be too low. Exact if PRINT_EXACT_LENGTH is set.
 
 	// store any data you may need later
 	mutable uint64_t myUserData;
@@ -72,7 +56,8 @@ struct MSF_CustomPrinter
 {
 	//-------------------------------------------------------------------------------------------------
 	// Final validation of print info. Make any final adjustments and return the maximum length you might
-	// need to print.
+	// need to print. If PRINT_EXACT_LENGTH is set in the flags return exactly what will be printed,
+	// an estimate is still safe but the buffer requested from realloc will be larger than needed.
 	// Do not set the max length directly.
 	//-------------------------------------------------------------------------------------------------
 	size_t(*ValidateUTF8)(MSF_PrintData& aPrintData, MSF_StringFormatType const& aValue);
@@ -116,7 +101,7 @@ namespace MSF_CustomPrint
 	//-------------------------------------------------------------------------------------------------
 	// verify format/type  and return max length in read mode, write mode must not fail and return number of characters written
 	// reserved characters:
-	// 'c', 'C', 's', 'S', 'd', 'i', 'o', 'u', 'x', 'X', 'p', 'P', 'e', 'E', 'f', 'g', 'G', 'a', 'A', 'n'
+	// 'c', 'C', 's', 'S', 'd', 'i', 'o', 'u', 'x', 'X', 'b', 'B', 'p', 'P', 'e', 'E', 'f', 'F', 'g', 'G', 'r', 'R', 'a', 'A', 'n'
 	//-------------------------------------------------------------------------------------------------
 	void RegisterPrintFunction(char aChar, uint64_t someSupportedTypes, MSF_CustomPrinter aPrinter);
 
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "MSF_Format.h"
+
+//-------------------------------------------------------------------------------------------------
+// Output target for single pass formatting. Characters are written directly between myWrite and
+// myEnd, when more space is needed myReserve is called to make room. Without a reserve function
+// the sink is a fixed size buffer.
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+struct MSF_FormatSink
+{
+	//-------------------------------------------------------------------------------------------------
+	// Make room for at least aRequired characters at myWrite, return false if that isn't possible.
+	// It's fine to make less room than requested and return false, text is written in pieces where it can be.
+	// Called with 0 once formatting is complete to output anything still pending.
+	//-------------------------------------------------------------------------------------------------
+	typedef bool (*ReserveFunction)(MSF_FormatSink& aSink, size_t aRequired);
+
+	MSF_FormatSink(Char* aBuffer, size_t aLength, ReserveFunction aReserve = nullptr)
+		: myStart(aBuffer)
+		, myWrite(aBuffer)
+		, myEnd(aBuffer + aLength)
+		, myFlushed(0)
+		, myReserve(aReserve)
+	{}
+
+	template <size_t Size>
+	explicit MSF_FormatSink(Char (&aBuffer)[Size])
+		: MSF_FormatSink(aBuffer, Size)
+	{}
+
+	bool Reserve(size_t aRequired) { return size_t(myEnd - myWrite) >= aRequired || (myReserve && myReserve(*this, aRequired)); }
+	bool Finish() { return !myReserve || myReserve(*this, 0); }
+
+	// total number of characters written, including those already flushed
+	size_t Length() const { return myFlushed + (myWrite - myStart); }
+
+	Char* myStart;
+	Char* myWrite;
+	Char* myEnd;
+	size_t myFlushed; // characters no longer in the buffer
+	ReserveFunction myReserve;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Sink that grows a buffer using the same realloc callback as MSF_FormatString. The buffer can start
+// empty (nullptr) and is only reallocated when the printed text actually needs more space.
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+struct MSF_GrowableFormatSink : public MSF_FormatSink<Char>
+{
+	MSF_GrowableFormatSink(Char* aBuffer, size_t aLength, Char* (*aReallocFunction)(Char*, size_t, void*), void* aUserData = nullptr)
+		: MSF_FormatSink<Char>(aBuffer, aLength, &Grow)
+		, myReallocFunction(aReallocFunction)
+		, myUserData(aUserData)
+	{}
+
+	Char* GetBuffer() const { return this->myStart; }
+	size_t GetCapacity() const { return this->myEnd - this->myStart; }
+
+private:
+	static bool Grow(MSF_FormatSink<Char>& aSink, size_t aRequired)
+	{
+		if (!aRequired)
+			return true;
+
+		MSF_GrowableFormatSink& sink = static_cast<MSF_GrowableFormatSink&>(aSink);
+		size_t const used = sink.myWrite - sink.myStart;
+		size_t capacity = sink.GetCapacity() * 2;
+		if (capacity < used + aRequired)
+			capacity = used + aRequired;
+
+		Char* buffer = sink.myReallocFunction(sink.myStart, capacity, sink.myUserData);
+		if (!buffer)
+			return false;
+
+		sink.myStart = buffer;
+		sink.myWrite = buffer + used;
+		sink.myEnd = buffer + capacity;
+		return true;
+	}
+
+	Char* (*myReallocFunction)(Char*, size_t, void*);
+	void* myUserData;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Sink that streams the output in chunks through a small buffer, i.e. to a file or socket.
+// The null terminator is never passed to the write function. Literal text can be any length, a
+// printed argument that doesn't fit in the buffer is printed to a temporary one and written in pieces.
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+struct MSF_ChunkedFormatSink : public MSF_FormatSink<Char>
+{
+	MSF_ChunkedFormatSink(Char* aBuffer, size_t aLength, void (*aWriteFunction)(Char const*, size_t, void*), void* aUserData = nullptr)
+		: MSF_FormatSink<Char>(aBuffer, aLength, &Flush)
+		, myWriteFunction(aWriteFunction)
+		, myUserData(aUserData)
+	{}
+
+private:
+	static bool Flush(MSF_FormatSink<Char>& aSink, size_t aRequired)
+	{
+		MSF_ChunkedFormatSink& sink = static_cast<MSF_ChunkedFormatSink&>(aSink);
+		size_t const pending = sink.myWrite - sink.myStart;
+		if (pending)
+		{
+			sink.myWriteFunction(sink.myStart, pending, sink.myUserData);
+			sink.myFlushed += pending;
+			sink.myWrite = sink.myStart;
+		}
+
+		return size_t(sink.myEnd - sink.myStart) >= aRequired;
+	}
+
+	void (*myWriteFunction)(Char const*, size_t, void*);
+	void* myUserData;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Parse and print in a single pass, writing directly into the sink. Returns the number of characters
+// printed (not including the null terminator), or <0 on error. Unlike MSF_FormatString, errors
+// found part way through the string leave everything printed up to that point in the sink.
+// A null terminator is written after the output but not counted.
+//-------------------------------------------------------------------------------------------------
+extern intptr_t MSF_FormatToSink(MSF_StringFormat const& aStringFormat, MSF_FormatSink<char>& aSink);
+extern intptr_t MSF_FormatToSink(MSF_StringFormatUTF8 const& aStringFormat, MSF_FormatSink<char8_t>& aSink);
+extern intptr_t MSF_FormatToSink(MSF_StringFormatUTF16 const& aStringFormat, MSF_FormatSink<char16_t>& aSink);
+extern intptr_t MSF_FormatToSink(MSF_StringFormatUTF32 const& aStringFormat, MSF_FormatSink<char32_t>& aSink);
+extern intptr_t MSF_FormatToSink(MSF_StringFormatWChar const& aStringFormat, MSF_FormatSink<wchar_t>& aSink);
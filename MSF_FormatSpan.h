@@ -0,0 +1,59 @@
+#pragma once
+
+#include "MSF_FormatSink.h"
+
+//-------------------------------------------------------------------------------------------------
+// A contiguous array of values to print with MSF_FormatSpan. Every value has the same type which
+// must be a built in integer, floating point or pointer type.
+//-------------------------------------------------------------------------------------------------
+struct MSF_SpanValues
+{
+	template <typename Type>
+	MSF_SpanValues(Type const* someValues, size_t aCount)
+		: myValues(someValues)
+		, myCount(aCount)
+		, myStride(sizeof(Type))
+		, myType(typename MSF_StringFormatTypeLookup<Type>::Format(Type()))
+	{}
+
+	template <typename Type, size_t Count>
+	explicit MSF_SpanValues(Type const (&someValues)[Count])
+		: MSF_SpanValues(someValues, Count)
+	{}
+
+	void const* myValues;
+	size_t myCount;
+	size_t myStride;
+	MSF_StringFormatType myType; // type info shared by all the values, the value itself is unused
+};
+
+//-------------------------------------------------------------------------------------------------
+// Print every value in a span with the same format string, with aSeparator written between values.
+// The format string is parsed once and must have exactly one print specifier, any literal text around
+// it is repeated for every value. The output of each value matches printing it with MSF_FormatToSink.
+// i.e. MSF_FormatSpan(sink, "{:x}", MSF_SpanValues(values), ", ") -> "1, ff, 2a"
+// Returns the number of characters printed (not including the null terminator), or <0 on error.
+// Errors are handled the same as MSF_FormatToSink.
+//-------------------------------------------------------------------------------------------------
+extern intptr_t MSF_FormatSpan(MSF_FormatSink<char>& aSink, char const* aFormat, MSF_SpanValues const& someValues, char const* aSeparator = nullptr);
+extern intptr_t MSF_FormatSpan(MSF_FormatSink<char8_t>& aSink, char8_t const* aFormat, MSF_SpanValues const& someValues, char8_t const* aSeparator = nullptr);
+extern intptr_t MSF_FormatSpan(MSF_FormatSink<char16_t>& aSink, char16_t const* aFormat, MSF_SpanValues const& someValues, char16_t const* aSeparator = nullptr);
+extern intptr_t MSF_FormatSpan(MSF_FormatSink<char32_t>& aSink, char32_t const* aFormat, MSF_SpanValues const& someValues, char32_t const* aSeparator = nullptr);
+extern intptr_t MSF_FormatSpan(MSF_FormatSink<wchar_t>& aSink, wchar_t const* aFormat, MSF_SpanValues const& someValues, wchar_t const* aSeparator = nullptr);
+
+//-------------------------------------------------------------------------------------------------
+// snprintf style calls to print a span into static buffers
+//-------------------------------------------------------------------------------------------------
+template <typename Char, size_t Size, typename Type>
+intptr_t MSF_FormatSpan(Char (&aBuffer)[Size], Char const* aFormat, Type const* someValues, size_t aCount, Char const* aSeparator = nullptr)
+{
+	MSF_FormatSink<Char> sink(aBuffer);
+	return MSF_FormatSpan(sink, aFormat, MSF_SpanValues(someValues, aCount), aSeparator);
+}
+
+template <typename Char, size_t Size, typename Type, size_t Count>
+intptr_t MSF_FormatSpan(Char (&aBuffer)[Size], Char const* aFormat, Type const (&someValues)[Count], Char const* aSeparator = nullptr)
+{
+	MSF_FormatSink<Char> sink(aBuffer);
+	return MSF_FormatSpan(sink, aFormat, MSF_SpanValues(someValues, Count), aSeparator);
+}
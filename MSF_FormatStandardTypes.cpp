@@ -5,6 +5,8 @@
 #include "MSF_UTF.h"
 #include "MSF_Utilities.h"
 
+#include <string.h>
+
 //-------------------------------------------------------------------------------------------------
 // Windows printf respects the 0 flag, posix doesn't
 //-------------------------------------------------------------------------------------------------
@@ -367,185 +369,304 @@ namespace MSF_StringFormatString
 //-------------------------------------------------------------------------------------------------
 namespace MSF_StringFormatInt
 {
-	size_t Validate(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
-	{
-		MSF_ASSERT(aValue.myType & ValidTypes);
-		static_assert(MSF_StringFormatType::Type8 == 2, "Format type indexes changed, this formula no longer works");
-
-		// type = (2/4/8/16) target = (3/5/10/20)
-		// type / 2 * 3 = (3/6/12/24) - type >> 2 (0/1/2/4) = (3/5/10/20), exactly what we need, + 1 for sign, just in case its negative
-		size_t maxLength = size_t(aValue.myType / 2 * 3 - (aValue.myType >> 2));
-		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision);
-		return MSF_IntMax<size_t>(maxLength, aData.myWidth) + 1;
-	}
-
-	size_t ValidateOctal(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
-	{
-		MSF_ASSERT(aValue.myType & ValidTypes);
-
-		// type = (2/4/8/16) target = (3/6/11/23)
-		// type / 2 * 3 = (3/6/12/24) which is close enough for me, + prefix 'o'
-		size_t maxLength = size_t((aValue.myType / 2 * 3));
-		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision) + (aData.myFlags & PRINT_PREFIX);
-		return MSF_IntMax<size_t>(maxLength, aData.myWidth);
-	}
-
-	size_t ValidateHex(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
-	{
-		MSF_ASSERT(aValue.myType & ValidTypes);
-
-		// make sure these calculations stay the same as those in GetTypeMaxLength
-		// type = (2/4/8/16)... perfect, add prefix of '0x'.
-		size_t maxLength = size_t((aValue.myType));
-		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision) + (aData.myFlags & PRINT_PREFIX) * 2;
-		return MSF_IntMax<size_t>(maxLength, aData.myWidth);
-	}
-
-	size_t ValidatePointer(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
-	{
-		(void)aValue;
-		MSF_ASSERT(aValue.myType & ValidTypes);
-
-		// always print pointer sized
-		size_t maxLength = sizeof(void*) * 2;
-		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision);
-
-#if MSF_POINTER_ADD_PREFIX
-		maxLength += 2;
-#endif // MSF_POINTER_ADD_PREFIX
-
-#if MSF_POINTER_ADD_SIGN_OR_BLANK
-		maxLength += !!(aData.myFlags & (PRINT_SIGN | PRINT_BLANK));
-#endif // MSF_POINTER_ADD_SIGN_OR_BLANK
-
-		return MSF_IntMax<size_t>(maxLength, aData.myWidth);
-	}
+	//-------------------------------------------------------------------------------------------------
+	// Everything needed to print an integer except the digits themselves. Shared between printing and
+	// exact length validation so the two can never disagree.
+	//-------------------------------------------------------------------------------------------------
+	template <typename Type>
+	struct Layout
+	{
+		Type Value;
+		uint32_t Radix;
+		uint32_t Precision;
+		uint32_t PrefixLength;
+		uint8_t Flags;
+		char HexStart;
+		char Sign;
+		bool PrintSign;
+		bool AddPrefix;
+	};
 
-	template <typename Char, typename Type, typename SignedType>
-	size_t Print(Char* aBuffer, Char const* aBufferEnd, MSF_PrintData const& aData, Type aValue)
+	// returns false if the value should be printed as "(nil)" instead
+	template <typename Type, typename SignedType>
+	bool SetupLayout(Layout<Type>& aLayout, MSF_PrintData const& aData, Type aValue)
 	{
-		bool isSigned = aData.myPrintChar == 'd' || aData.myPrintChar == 'i';
-		bool addPrefix = false;
-		bool printSign = false;
-		Char sign = ' ';
+		bool const isSigned = aData.myPrintChar == 'd' || aData.myPrintChar == 'i';
+		aLayout.AddPrefix = false;
+		aLayout.PrintSign = false;
+		aLayout.Sign = ' ';
+		aLayout.PrefixLength = 0;
 
-		char start = (aData.myPrintChar == 'X' || aData.myPrintChar == 'P' || (MSF_POINTER_PRINT_CAPS && aData.myPrintChar == 'p')) ? 'A' : 'a';
-		auto radix = 10;
-		auto precision = aData.myPrecision;
-		auto flags = aData.myFlags;
+		aLayout.HexStart = (aData.myPrintChar == 'X' || aData.myPrintChar == 'P' || (MSF_POINTER_PRINT_CAPS && aData.myPrintChar == 'p')) ? 'A' : 'a';
+		aLayout.Radix = 10;
+		aLayout.Precision = aData.myPrecision;
+		aLayout.Flags = aData.myFlags;
 
-		Type value;
 		if (isSigned)
 		{
 			SignedType signedValue = aValue;
 			if (signedValue < 0)
 			{
-				value = -signedValue;
+				aLayout.Value = -signedValue;
 
-				printSign = true;
-				sign = '-';
+				aLayout.PrintSign = true;
+				aLayout.Sign = '-';
 			}
 			else
 			{
-				value = signedValue;
-				if (flags & PRINT_SIGN)
+				aLayout.Value = signedValue;
+				if (aLayout.Flags & PRINT_SIGN)
 				{
-					printSign = true;
-					sign = '+';
+					aLayout.PrintSign = true;
+					aLayout.Sign = '+';
 				}
-				else if (flags & PRINT_BLANK)
+				else if (aLayout.Flags & PRINT_BLANK)
 				{
-					printSign = true;
-					sign = ' ';
+					aLayout.PrintSign = true;
+					aLayout.Sign = ' ';
 				}
 			}
 		}
 		else
-			value = aValue;
+			aLayout.Value = aValue;
 
 		switch (aData.myPrintChar)
 		{
 		case 'o':
-			radix = 8;
-			addPrefix = (flags & PRINT_PREFIX) != 0;
+			aLayout.Radix = 8;
+			aLayout.AddPrefix = (aLayout.Flags & PRINT_PREFIX) != 0;
 			break;
 		case 'X':
 		case 'x':
-			radix = 16;
-			addPrefix = (flags & PRINT_PREFIX) != 0;
+			aLayout.Radix = 16;
+			aLayout.AddPrefix = (aLayout.Flags & PRINT_PREFIX) != 0;
+			break;
+		case 'B':
+		case 'b':
+			aLayout.Radix = 2;
+			aLayout.AddPrefix = (aLayout.Flags & PRINT_PREFIX) != 0;
 			break;
 		case 'P':
 		case 'p':
 
 #if MSF_POINTER_PRINT_NIL
-			if (value == 0)
-			{
-				Char nil[] = { '(', 'n', 'i', 'l', ')', 0 };
-				aData.myUserData = 5;
-				return MSF_CustomPrint::PrintType('s', aBuffer, aBufferEnd, aData, MSF_StringFormatType(nil));
-			}
+			if (aLayout.Value == 0)
+				return false;
 #endif
 
-			radix = 16;
+			aLayout.Radix = 16;
 
 #if MSF_POINTER_FORCE_PRECISION
-			precision = sizeof(void*) * 2;
-			flags |= PRINT_PRECISION;
+			aLayout.Precision = sizeof(void*) * 2;
+			aLayout.Flags |= PRINT_PRECISION;
 #endif // MSF_POINTER_FORCE_PRECISION
 
 #if MSF_POINTER_ADD_PREFIX
-			addPrefix = true;
+			aLayout.AddPrefix = true;
 #endif // MSF_POINTER_ADD_PREFIX
 
 #if MSF_POINTER_ADD_SIGN_OR_BLANK
-			if (flags & PRINT_SIGN)
+			if (aLayout.Flags & PRINT_SIGN)
 			{
-				printSign = true;
-				sign = '+';
+				aLayout.PrintSign = true;
+				aLayout.Sign = '+';
 			}
-			else if (flags & PRINT_BLANK)
+			else if (aLayout.Flags & PRINT_BLANK)
 			{
-				printSign = true;
-				sign = ' ';
+				aLayout.PrintSign = true;
+				aLayout.Sign = ' ';
 			}
 #endif // MSF_POINTER_ADD_SIGN_OR_BLANK
 			break;
 		}
 
-		if (flags & PRINT_PRECISION)
+		if (aLayout.Flags & PRINT_PRECISION)
 		{
-			flags &= ~PRINT_ZERO;
+			aLayout.Flags &= ~PRINT_ZERO;
 		}
 
-		auto utoa = MSF_UnsignedToString<Type, Char>(value, radix, start);
-		Char const* string = utoa;
-		auto length = utoa.Length();
+		return true;
+	}
 
-		Char const prefix[2] = { '0', Char(start + ('x' - 'a')) };
-		uint32_t prefixLen = 0;
-		if (string[0] != '0' && addPrefix)
+	// adjust for the digits that will be printed and return the length without any width padding
+	template <typename Type>
+	uint32_t FinishLayout(Layout<Type>& aLayout, MSF_PrintData const& aData, uint32_t& aLength)
+	{
+		if (aLayout.Value != 0 && aLayout.AddPrefix)
 		{
-			if (radix == 8)
+			if (aLayout.Radix == 8)
 			{
-				prefixLen = 1;
-				if (precision)
+				aLayout.PrefixLength = 1;
+				if (aLayout.Precision)
 				{
-					--precision;
+					--aLayout.Precision;
 				}
 			}
-			else if (radix == 16)
+			else
 			{
-				prefixLen = 2;
+				aLayout.PrefixLength = 2;
 			}
 		}
-		else if (string[0] == '0' && (flags & PRINT_PRECISION) && precision == 0)
+		else if (aLayout.Value == 0 && (aLayout.Flags & PRINT_PRECISION) && aLayout.Precision == 0)
 		{
 			// Odd hack where we're actually printing the octal prefix 0 not the value 0
-			if (aData.myPrintChar != 'o' || !addPrefix)
-				--length;
+			if (aData.myPrintChar != 'o' || !aLayout.AddPrefix)
+				--aLength;
+		}
+
+		return MSF_IntMax<uint32_t>(aLength, aLayout.Precision) + aLayout.PrefixLength + aLayout.PrintSign;
+	}
+
+	// 64 bit conversion for everything but 128 bit values
+	template <typename Type>
+	uint32_t CountDigits(Type aValue, uint32_t aRadix) { return MSF_CountDigits(aValue, aRadix); }
+	template <typename Char, typename Type>
+	void WriteDigits(Char* aString, uint32_t aLength, Type aValue, uint32_t aRadix, char aHexStart) { MSF_WriteDigits(aString, aLength, aValue, aRadix, aHexStart); }
+
+#if MSF_USE_INT128
+	uint32_t CountDigits(MSF_UInt128 aValue, uint32_t aRadix) { return MSF_CountDigits128(aValue, aRadix); }
+	template <typename Char>
+	void WriteDigits(Char* aString, uint32_t aLength, MSF_UInt128 aValue, uint32_t aRadix, char aHexStart) { MSF_WriteDigits128(aString, aLength, aValue, aRadix, aHexStart); }
+
+	// 128 bit values are referenced and copies may not be aligned
+	MSF_UInt128 ReadValue128(MSF_StringFormatType const& aValue)
+	{
+		MSF_UInt128 value;
+		memcpy(&value, aValue.myUserType, sizeof(value));
+		return value;
+	}
+#endif
+
+	template <typename Type, typename SignedType>
+	size_t ExactLength(MSF_PrintData const& aData, Type aValue)
+	{
+		Layout<Type> layout;
+		if (!SetupLayout<Type, SignedType>(layout, aData, aValue))
+			return MSF_IntMax<size_t>(5, aData.myWidth); // "(nil)"
+
+		uint32_t length = CountDigits(layout.Value, layout.Radix);
+		return MSF_IntMax<size_t>(FinishLayout(layout, aData, length), aData.myWidth);
+	}
+
+	size_t ExactLength(MSF_PrintData const& aData, MSF_StringFormatType const& aValue)
+	{
+		switch (aValue.myType)
+		{
+#if MSF_USE_INT128
+		case MSF_StringFormatType::Type128:
+			return ExactLength<MSF_UInt128, MSF_Int128>(aData, ReadValue128(aValue));
+#endif
+		case MSF_StringFormatType::Type64:
+			return ExactLength<uint64_t, int64_t>(aData, aValue.myValue64);
+		case MSF_StringFormatType::Type32:
+			return ExactLength<uint32_t, int32_t>(aData, aValue.myValue32);
+		case MSF_StringFormatType::Type16:
+			return ExactLength<uint16_t, int16_t>(aData, aValue.myValue16);
+		case MSF_StringFormatType::Type8:
+			return ExactLength<uint8_t, int8_t>(aData, aValue.myValue8);
+		}
+
+		MSF_ASSERT(false);
+		return 0;
+	}
+
+	size_t Validate(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
+	{
+		MSF_ASSERT(aValue.myType & ValidTypes);
+		static_assert(MSF_StringFormatType::Type8 == 2, "Format type indexes changed, this formula no longer works");
+
+		if (aData.myFlags & PRINT_EXACT_LENGTH)
+			return ExactLength(aData, aValue);
+
+		// type = (2/4/8/16) target = (3/5/10/20)
+		// type / 2 * 3 = (3/6/12/24) - type >> 2 (0/1/2/4) = (3/5/10/20), exactly what we need, + 1 for sign, just in case its negative
+		size_t maxLength = aValue.myType == MSF_StringFormatType::Type128 ? 39 : size_t(aValue.myType / 2 * 3 - (aValue.myType >> 2));
+		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision);
+		return MSF_IntMax<size_t>(maxLength, aData.myWidth) + 1;
+	}
+
+	size_t ValidateOctal(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
+	{
+		MSF_ASSERT(aValue.myType & ValidTypes);
+
+		if (aData.myFlags & PRINT_EXACT_LENGTH)
+			return ExactLength(aData, aValue);
+
+		// type = (2/4/8/16) target = (3/6/11/23)
+		// type / 2 * 3 = (3/6/12/24) which is close enough for me, + prefix 'o'
+		size_t maxLength = aValue.myType == MSF_StringFormatType::Type128 ? 43 : size_t((aValue.myType / 2 * 3));
+		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision) + (aData.myFlags & PRINT_PREFIX);
+		return MSF_IntMax<size_t>(maxLength, aData.myWidth);
+	}
+
+	size_t ValidateHex(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
+	{
+		MSF_ASSERT(aValue.myType & ValidTypes);
+
+		if (aData.myFlags & PRINT_EXACT_LENGTH)
+			return ExactLength(aData, aValue);
+
+		// make sure these calculations stay the same as those in GetTypeMaxLength
+		// type = (2/4/8/16)... perfect, add prefix of '0x'.
+		size_t maxLength = aValue.myType == MSF_StringFormatType::Type128 ? 32 : size_t((aValue.myType));
+		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision) + (aData.myFlags & PRINT_PREFIX) * 2;
+		return MSF_IntMax<size_t>(maxLength, aData.myWidth);
+	}
+
+	size_t ValidateBinary(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
+	{
+		MSF_ASSERT(aValue.myType & ValidTypes);
+
+		if (aData.myFlags & PRINT_EXACT_LENGTH)
+			return ExactLength(aData, aValue);
+
+		// type = (2/4/8/16) target = (8/16/32/64), add prefix of '0b'.
+		size_t maxLength = aValue.myType == MSF_StringFormatType::Type128 ? 128 : size_t(aValue.myType * 4);
+		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision) + (aData.myFlags & PRINT_PREFIX) * 2;
+		return MSF_IntMax<size_t>(maxLength, aData.myWidth);
+	}
+
+	size_t ValidatePointer(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
+	{
+		(void)aValue;
+		MSF_ASSERT(aValue.myType & PointerValidTypes);
+
+		if (aData.myFlags & PRINT_EXACT_LENGTH)
+			return ExactLength(aData, aValue);
+
+		// always print pointer sized
+		size_t maxLength = sizeof(void*) * 2;
+		maxLength = MSF_IntMax<size_t>(maxLength, aData.myPrecision);
+
+#if MSF_POINTER_ADD_PREFIX
+		maxLength += 2;
+#endif // MSF_POINTER_ADD_PREFIX
+
+#if MSF_POINTER_ADD_SIGN_OR_BLANK
+		maxLength += !!(aData.myFlags & (PRINT_SIGN | PRINT_BLANK));
+#endif // MSF_POINTER_ADD_SIGN_OR_BLANK
+
+		return MSF_IntMax<size_t>(maxLength, aData.myWidth);
+	}
+
+	template <typename Char, typename Type, typename SignedType>
+	size_t Print(Char* aBuffer, Char const* aBufferEnd, MSF_PrintData const& aData, Type aValue)
+	{
+		Layout<Type> layout;
+		if (!SetupLayout<Type, SignedType>(layout, aData, aValue))
+		{
+			Char nil[] = { '(', 'n', 'i', 'l', ')', 0 };
+			aData.myUserData = 5;
+			return MSF_CustomPrint::PrintType('s', aBuffer, aBufferEnd, aData, MSF_StringFormatType(nil));
 		}
 
-		uint32_t requiredLength = MSF_IntMax<uint32_t>(length, precision) + prefixLen + printSign;
+		// digits are counted up front so everything can be written straight into its final place
+		uint32_t length = CountDigits(layout.Value, layout.Radix);
+		uint32_t const requiredLength = FinishLayout(layout, aData, length);
+		uint32_t const precision = layout.Precision;
+		uint8_t const flags = layout.Flags;
+
+		Char const prefix[2] = { '0', Char(layout.Radix == 2 ? aData.myPrintChar : layout.HexStart + ('x' - 'a')) };
 
 		Char* bufferWrite = aBuffer;
 
@@ -557,15 +678,15 @@ namespace MSF_StringFormatInt
 			bufferWrite += splatChars;
 		}
 		// if there's a +/- or space before the number write it now (before padding with zeros)
-		if (printSign)
+		if (layout.PrintSign)
 		{
-			*bufferWrite++ = sign;
+			*bufferWrite++ = layout.Sign;
 		}
 		// write the prefix before padding with zeros
-		if (prefixLen)
+		if (layout.PrefixLength)
 		{
-			MSF_CopyChars(bufferWrite, aBufferEnd, prefix, prefixLen);
-			bufferWrite += prefixLen;
+			MSF_CopyChars(bufferWrite, aBufferEnd, prefix, layout.PrefixLength);
+			bufferWrite += layout.PrefixLength;
 		}
 		// if we're right aligned and have space and are using zeros write them now
 		if (requiredLength < aData.myWidth && !(flags & PRINT_LEFTALIGN) && flags & PRINT_ZERO)
@@ -574,16 +695,19 @@ namespace MSF_StringFormatInt
 			MSF_SplatChars(bufferWrite, aBufferEnd, '0', splatChars);
 			bufferWrite += splatChars;
 		}
-		// if we're less than the wanted precision pad with some zeros
-		if (length < precision)
+		// write the value along with any zeros needed to reach the wanted precision,
+		// length is 0 when a zero value is hidden by a zero precision
+		length = MSF_IntMax(length, precision);
+		if (length)
 		{
-			size_t const splatChars = precision - length;
-			MSF_SplatChars(bufferWrite, aBufferEnd, '0', splatChars);
-			bufferWrite += splatChars;
+			if (bufferWrite + length > aBufferEnd)
+			{
+				MSF_ASSERT(bufferWrite + length < aBufferEnd, "Supplied buffer is not big enough to write %d digits. It only has %d chars available", length, aBufferEnd - bufferWrite);
+				return bufferWrite - aBuffer;
+			}
+			WriteDigits(bufferWrite, length, layout.Value, layout.Radix, layout.HexStart);
+			bufferWrite += length;
 		}
-		// write the value
-		MSF_CopyChars(bufferWrite, aBufferEnd, string, length);
-		bufferWrite += length;
 
 		// if we're left aligned, have space and are using spaces then write them now
 		if (requiredLength < aData.myWidth && flags & PRINT_LEFTALIGN)
@@ -601,6 +725,10 @@ namespace MSF_StringFormatInt
 	{
 		switch (aData.myValue->myType)
 		{
+#if MSF_USE_INT128
+		case MSF_StringFormatType::Type128:
+			return Print<Char, MSF_UInt128, MSF_Int128>(aBuffer, aBufferEnd, aData, ReadValue128(*aData.myValue));
+#endif
 		case MSF_StringFormatType::Type64:
 			return Print<Char, uint64_t, int64_t>(aBuffer, aBufferEnd, aData, aData.myValue->myValue64);
 		case MSF_StringFormatType::Type32:
@@ -627,6 +755,11 @@ namespace MSF_StringFormatInt
 	{
 		return PrintShared(aBuffer, aBufferEnd, aData);
 	}
+
+	size_t CopyLength(MSF_StringFormatType const& aValue)
+	{
+		return aValue.myType == MSF_StringFormatType::Type128 ? 16 : 0;
+	}
 }
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
@@ -635,20 +768,30 @@ namespace MSF_StringFormatFloat
 	size_t Validate(MSF_PrintData& aData, MSF_StringFormatType const& aValue)
 	{
 		MSF_ASSERT(aValue.myType & ValidTypes);
-		static_assert(MSF_StringFormatType::Typefloat == 32, "Format type indexes changed, this formula no longer works");
-
-		// make sure these calculations stay the same as those in GetTypeMaxLength
-		int const extra = 7; // add sign, decimal place, and extra for exponent (e+999)
 		if (!(aData.myFlags & PRINT_PRECISION)) aData.myPrecision = 6;
-		size_t maxLength = size_t(aValue.myType / 2); // max length of floats is 16/32 chars for 32 bit and 64 bit respectively, + '.' '-'
-		return MSF_IntMax<size_t>(aData.myWidth + aData.myPrecision, maxLength) + extra;
+
+		// the only way to know for sure is to do the conversion
+		if (aData.myFlags & PRINT_EXACT_LENGTH)
+		{
+			if (aValue.myType == MSF_StringFormatType::Typefloat)
+				return MSF_FloatToStringLength(aValue.myfloat, aData.myPrintChar, aData.myWidth, aData.myPrecision, aData.myFlags);
+			return MSF_DoubleToStringLength(aValue.mydouble, aData.myPrintChar, aData.myWidth, aData.myPrecision, aData.myFlags);
+		}
+
+		// otherwise the exponent is enough for a tight bound
+		if (aValue.myType == MSF_StringFormatType::Typefloat)
+			return MSF_FloatToStringMaxLength(aValue.myfloat, aData.myPrintChar, aData.myWidth, aData.myPrecision, aData.myFlags);
+		return MSF_DoubleToStringMaxLength(aValue.mydouble, aData.myPrintChar, aData.myWidth, aData.myPrecision, aData.myFlags);
 	}
 
 	template <typename Char>
 	size_t PrintShared(Char* aBuffer, Char const* aBufferEnd, MSF_PrintData const& aData)
 	{
-		double value = aData.myValue->myType == MSF_StringFormatType::Typefloat ? aData.myValue->myfloat : aData.myValue->mydouble;
-		return MSF_DoubleToString(value, aBuffer, MSF_IntMin<size_t>(aData.myMaxLength, aBufferEnd - aBuffer), aData.myPrintChar, aData.myWidth, aData.myPrecision, aData.myFlags);
+		// + 1 since it always null terminates, there's always room for it since the whole string is null terminated
+		size_t const length = MSF_IntMin<size_t>(aData.myMaxLength + 1, aBufferEnd - aBuffer);
+		if (aData.myValue->myType == MSF_StringFormatType::Typefloat)
+			return MSF_FloatToString(aData.myValue->myfloat, aBuffer, length, aData.myPrintChar, aData.myWidth, aData.myPrecision, aData.myFlags);
+		return MSF_DoubleToString(aData.myValue->mydouble, aBuffer, length, aData.myPrintChar, aData.myWidth, aData.myPrecision, aData.myFlags);
 	}
 
 	size_t PrintUTF8(char* aBuffer, char const* aBufferEnd, MSF_PrintData const& aData)
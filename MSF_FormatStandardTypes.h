@@ -41,16 +41,21 @@ namespace MSF_StringFormatString
 //-------------------------------------------------------------------------------------------------
 namespace MSF_StringFormatInt
 {
-	constexpr uint32_t ValidTypes = MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64;
+	constexpr uint32_t ValidTypes = MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64 | MSF_StringFormatType::Type128;
+	// pointers are estimated as pointer sized so 128 bit values can't be printed with them
+	constexpr uint32_t PointerValidTypes = MSF_StringFormatType::Type8 | MSF_StringFormatType::Type16 | MSF_StringFormatType::Type32 | MSF_StringFormatType::Type64;
 
 	size_t Validate(MSF_PrintData& aData, MSF_StringFormatType const& aValue);
 	size_t ValidateOctal(MSF_PrintData& aData, MSF_StringFormatType const& aValue);
 	size_t ValidateHex(MSF_PrintData& aData, MSF_StringFormatType const& aValue);
+	size_t ValidateBinary(MSF_PrintData& aData, MSF_StringFormatType const& aValue);
 	size_t ValidatePointer(MSF_PrintData& aData, MSF_StringFormatType const& aValue);
 
 	size_t PrintUTF8(char* aBuffer, char const* aBufferEnd, MSF_PrintData const& aData);
 	size_t PrintUTF16(char16_t* aBuffer, char16_t const* aBufferEnd, MSF_PrintData const& aData);
 	size_t PrintUTF32(char32_t* aBuffer, char32_t const* aBufferEnd, MSF_PrintData const& aData);
+
+	size_t CopyLength(MSF_StringFormatType const& aValue);
 }
 
 //-------------------------------------------------------------------------------------------------
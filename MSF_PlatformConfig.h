@@ -33,7 +33,6 @@
 #undef MSF_POINTER_ADD_SIGN_OR_BLANK
 #undef MSF_POINTER_PRINT_CAPS
 #undef MSF_POINTER_PRINT_NIL
-#undef MSF_FLOAT_EPSILON_AFFECTED_BY_PRECISION
 
 #if MSF_FORMAT_SELECTED_PLATFORM == MSF_FORMAT_PLATFORM_ANDROID
 #define MSF_STRING_ALLOW_LEADING_ZERO 1
@@ -45,7 +44,6 @@
 #define MSF_POINTER_ADD_SIGN_OR_BLANK 0
 #define MSF_POINTER_PRINT_CAPS 0
 #define MSF_POINTER_PRINT_NIL 1
-#define MSF_FLOAT_EPSILON_AFFECTED_BY_PRECISION 0
 #elif MSF_FORMAT_SELECTED_PLATFORM == MSF_FORMAT_PLATFORM_APPLE
 #define MSF_STRING_ALLOW_LEADING_ZERO 1
 #define MSF_STRING_PRECISION_IS_CHARACTERS 0
@@ -56,7 +54,6 @@
 #define MSF_POINTER_ADD_SIGN_OR_BLANK 0
 #define MSF_POINTER_PRINT_CAPS 0
 #define MSF_POINTER_PRINT_NIL 1
-#define MSF_FLOAT_EPSILON_AFFECTED_BY_PRECISION 0
 #elif MSF_FORMAT_SELECTED_PLATFORM == MSF_FORMAT_PLATFORM_LINUX
 #define MSF_STRING_ALLOW_LEADING_ZERO 0
 #define MSF_STRING_PRECISION_IS_CHARACTERS 0
@@ -67,7 +64,6 @@
 #define MSF_POINTER_ADD_SIGN_OR_BLANK 1
 #define MSF_POINTER_PRINT_CAPS 0
 #define MSF_POINTER_PRINT_NIL 1
-#define MSF_FLOAT_EPSILON_AFFECTED_BY_PRECISION 0
 #elif MSF_FORMAT_SELECTED_PLATFORM == MSF_FORMAT_PLATFORM_WINDOWS
 #define MSF_STRING_ALLOW_LEADING_ZERO 1
 #define MSF_STRING_PRECISION_IS_CHARACTERS 1
@@ -78,7 +74,6 @@
 #define MSF_POINTER_ADD_SIGN_OR_BLANK 0
 #define MSF_POINTER_PRINT_CAPS 1
 #define MSF_POINTER_PRINT_NIL 0
-#define MSF_FLOAT_EPSILON_AFFECTED_BY_PRECISION 1
 #else
 #error "MSF_FORMAT_SELECTED_PLATFORM got set to an unknown platform value"
 #endif
@@ -95,6 +95,35 @@ inline MSF_SignedToString<int16_t, uint16_t> MSF_IntegerToString(int16_t aValue,
 inline MSF_SignedToString<int32_t, uint32_t> MSF_IntegerToString(int32_t aValue, uint32_t aRadix = 10, char aHexStart = 'a') { return MSF_SignedToString<int32_t, uint32_t>(aValue, aRadix, aHexStart); }
 inline MSF_SignedToString<int64_t, uint64_t> MSF_IntegerToString(int64_t aValue, uint32_t aRadix = 10, char aHexStart = 'a') { return MSF_SignedToString<int64_t, uint64_t>(aValue, aRadix, aHexStart); }
 
+//-------------------------------------------------------------------------------------------------
+// Number of digits needed to print a value in the given radix, 0 is a single digit.
+//-------------------------------------------------------------------------------------------------
+uint32_t MSF_CountDigits(uint64_t aValue, uint32_t aRadix = 10);
+
+//-------------------------------------------------------------------------------------------------
+// Write the digits of a value straight into a buffer, aLength must be at least MSF_CountDigits.
+// Exactly aLength characters are written, padded with leading zeros. There is no null terminator.
+//-------------------------------------------------------------------------------------------------
+void MSF_WriteDigits(char* aString, uint32_t aLength, uint64_t aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+void MSF_WriteDigits(char8_t* aString, uint32_t aLength, uint64_t aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+void MSF_WriteDigits(char16_t* aString, uint32_t aLength, uint64_t aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+void MSF_WriteDigits(char32_t* aString, uint32_t aLength, uint64_t aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+void MSF_WriteDigits(wchar_t* aString, uint32_t aLength, uint64_t aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+
+#if MSF_USE_INT128
+//-------------------------------------------------------------------------------------------------
+// 128 bit versions of the above, only radix 2, 8, 10 and 16 are supported. Values are split into
+// chunks that are converted with 64 bit math (i.e. a single divide by 10^19 for decimal).
+//-------------------------------------------------------------------------------------------------
+uint32_t MSF_CountDigits128(MSF_UInt128 aValue, uint32_t aRadix = 10);
+
+void MSF_WriteDigits128(char* aString, uint32_t aLength, MSF_UInt128 aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+void MSF_WriteDigits128(char8_t* aString, uint32_t aLength, MSF_UInt128 aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+void MSF_WriteDigits128(char16_t* aString, uint32_t aLength, MSF_UInt128 aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+void MSF_WriteDigits128(char32_t* aString, uint32_t aLength, MSF_UInt128 aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+void MSF_WriteDigits128(wchar_t* aString, uint32_t aLength, MSF_UInt128 aValue, uint32_t aRadix = 10, char aHexStart = 'a');
+#endif
+
 //-------------------------------------------------------------------------------------------------
 // Use DoubleToString to print float/double float values.
 // Unlike UnsignedToString/SignedToString you have more control over the format.
@@ -104,10 +133,16 @@ inline MSF_SignedToString<int64_t, uint64_t> MSF_IntegerToString(int64_t aValue,
 // Otherwise the returned value is the number of characters printed.
 // If nullptr is passed in as the output buffer then the number of required characters are returned. (NOT including null terminator)
 //
+// Digits are written straight in to the output so any precision can be printed. Stack use is fixed
+// by the value type and is the same for all character types, roughly 600 bytes for double and 350
+// for float on x64.
+//
 // aValue - The value to be printed
 // anOutput - The buffer to be printed to 
 // aLength - The number of characters available to write to in anOutput
-// aFormat - Equivalent to printf formats (f,F,e,E,g,G)
+// aFormat - Equivalent to printf formats (f,F,e,E,g,G,a,A), or r,R for the shortest representation
+//           that reads back as exactly the same value (precision is ignored). a,A only use the
+//           precision when PRINT_PRECISION is set, otherwise all significant hex digits are printed.
 // aWidth - the total number of characters to print
 // aPrecision - Truncate the number of character printed
 // aFlags - See MSF_PrintFlags.  These are equivalent to the printf flags "-+ 0#"
@@ -129,5 +164,30 @@ inline int MSF_DoubleToStringLength(double aValue, char aFormat = 'f', uint32_t
 	return MSF_DoubleToString(aValue, (char*)nullptr, 0, aFormat, aWidth, aPrecision, someFlags);
 }
 
-#define MSF_FloatToString MSF_DoubleToString
-#define MSF_FloatToStringLength MSF_DoubleToStringLength
+//-------------------------------------------------------------------------------------------------
+// Same as MSF_DoubleToString, but floats are converted directly instead of being widened to double.
+// They have their own shortest representation for 'r' and 'R' and use less stack for exact digits.
+//-------------------------------------------------------------------------------------------------
+int MSF_FloatToString(float aValue, char* anOutput, size_t aLength, char aFormat = 'f', uint32_t aWidth = 0, uint32_t aPrecision = 6, uint32_t someFlags = 0);
+int MSF_FloatToString(float aValue, char8_t* anOutput, size_t aLength, char aFormat = 'f', uint32_t aWidth = 0, uint32_t aPrecision = 6, uint32_t someFlags = 0);
+int MSF_FloatToString(float aValue, char16_t* anOutput, size_t aLength, char aFormat = 'f', uint32_t aWidth = 0, uint32_t aPrecision = 6, uint32_t someFlags = 0);
+int MSF_FloatToString(float aValue, char32_t* anOutput, size_t aLength, char aFormat = 'f', uint32_t aWidth = 0, uint32_t aPrecision = 6, uint32_t someFlags = 0);
+
+template<typename Char, uint32_t Size>
+int MSF_FloatToString(float aValue, Char(&anOutput)[Size], char aFormat = 'f', uint32_t aWidth = 0, uint32_t aPrecision = 6, uint32_t someFlags = 0)
+{
+	return MSF_FloatToString(aValue, anOutput, Size, aFormat, aWidth, aPrecision, someFlags);
+}
+
+inline int MSF_FloatToStringLength(float aValue, char aFormat = 'f', uint32_t aWidth = 0, uint32_t aPrecision = 6, uint32_t someFlags = 0)
+{
+	return MSF_FloatToString(aValue, (char*)nullptr, 0, aFormat, aWidth, aPrecision, someFlags);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Upper bound of the length printed by MSF_DoubleToString/MSF_FloatToString (NOT including null
+// terminator). Only the exponent of the value is looked at so this is much cheaper than getting the
+// exact length, it's exact for a,A.
+//-------------------------------------------------------------------------------------------------
+int MSF_DoubleToStringMaxLength(double aValue, char aFormat = 'f', uint32_t aWidth = 0, uint32_t aPrecision = 6, uint32_t someFlags = 0);
+int MSF_FloatToStringMaxLength(float aValue, char aFormat = 'f', uint32_t aWidth = 0, uint32_t aPrecision = 6, uint32_t someFlags = 0);
@@ -1,6 +1,11 @@
 #include "MSF_UTF.h"
 #include "MSF_Assert.h"
 #include "MSF_Utilities.h"
+#include <string.h>
+
+#if MSF_USE_SIMD
+#include <emmintrin.h>
+#endif
 
 //-------------------------------------------------------------------------------------------------
 // The leader bits of the the first character tells you how many bytes to use.
@@ -186,6 +191,84 @@ uint32_t MSF_WriteCodePoint(uint32_t aCodePoint, wchar_t aStringOut[4 / sizeof(w
 {
 	return MSF_WriteCodePointInternal(aCodePoint, (MSF_WChar*)aStringOut);
 }
+#if MSF_USE_SIMD
+//-------------------------------------------------------------------------------------------------
+// Ascii is a single element in every encoding so runs of it are copied 16 characters at a time.
+// Load narrows 16 characters to bytes and returns a bit for each one that is ascii (not including
+// the null terminator), Store widens them back out to the output size.
+//-------------------------------------------------------------------------------------------------
+template <size_t CharSize>
+struct MSF_UTFBlock;
+
+template <>
+struct MSF_UTFBlock<1>
+{
+	MSF_NO_SANITIZE_ADDRESS static uint32_t Load(void const* aString, __m128i& someCharsOut)
+	{
+		someCharsOut = _mm_loadu_si128((__m128i const*)aString);
+
+		// ascii without the null terminator is 1-127, the only positive signed bytes
+		return uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(someCharsOut, _mm_setzero_si128())));
+	}
+
+	static void Store(void* aString, __m128i someChars)
+	{
+		_mm_storeu_si128((__m128i*)aString, someChars);
+	}
+};
+
+template <>
+struct MSF_UTFBlock<2>
+{
+	MSF_NO_SANITIZE_ADDRESS static uint32_t Load(void const* aString, __m128i& someCharsOut)
+	{
+		// anything over 0xff saturates to a byte that isn't ascii
+		__m128i const* string = (__m128i const*)aString;
+		someCharsOut = _mm_packus_epi16(_mm_loadu_si128(string), _mm_loadu_si128(string + 1));
+		return uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(someCharsOut, _mm_setzero_si128())));
+	}
+
+	static void Store(void* aString, __m128i someChars)
+	{
+		__m128i const zero = _mm_setzero_si128();
+		_mm_storeu_si128((__m128i*)aString, _mm_unpacklo_epi8(someChars, zero));
+		_mm_storeu_si128((__m128i*)aString + 1, _mm_unpackhi_epi8(someChars, zero));
+	}
+};
+
+template <>
+struct MSF_UTFBlock<4>
+{
+	MSF_NO_SANITIZE_ADDRESS static uint32_t Load(void const* aString, __m128i& someCharsOut)
+	{
+		// same as 16 bit, but saturate down to 16 bits first
+		__m128i const* string = (__m128i const*)aString;
+		__m128i const low = _mm_packs_epi32(_mm_loadu_si128(string), _mm_loadu_si128(string + 1));
+		__m128i const high = _mm_packs_epi32(_mm_loadu_si128(string + 2), _mm_loadu_si128(string + 3));
+		someCharsOut = _mm_packus_epi16(low, high);
+		return uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(someCharsOut, _mm_setzero_si128())));
+	}
+
+	static void Store(void* aString, __m128i someChars)
+	{
+		__m128i const zero = _mm_setzero_si128();
+		__m128i const low = _mm_unpacklo_epi8(someChars, zero);
+		__m128i const high = _mm_unpackhi_epi8(someChars, zero);
+		_mm_storeu_si128((__m128i*)aString, _mm_unpacklo_epi16(low, zero));
+		_mm_storeu_si128((__m128i*)aString + 1, _mm_unpackhi_epi16(low, zero));
+		_mm_storeu_si128((__m128i*)aString + 2, _mm_unpacklo_epi16(high, zero));
+		_mm_storeu_si128((__m128i*)aString + 3, _mm_unpackhi_epi16(high, zero));
+	}
+};
+
+//-------------------------------------------------------------------------------------------------
+// Blocks are read past the null terminator, which is only safe if they stay in the same page
+//-------------------------------------------------------------------------------------------------
+inline bool MSF_UTFCanLoadBlock(void const* aString, size_t aSize)
+{
+	return ((uintptr_t)aString & 4095) <= 4096 - aSize;
+}
+#endif // MSF_USE_SIMD
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 template <typename CharTo, typename CharFrom>
@@ -193,8 +276,38 @@ MSF_CharactersWritten MSF_UTFCopyShared(CharTo* aStringOut, size_t aBufferLength
 {
 	MSF_CharactersWritten written = { 0, 0 };
 
-	while (*aStringIn && written.Characters < aCharacterLimit)
+	while (written.Characters < aCharacterLimit)
 	{
+#if MSF_USE_SIMD
+		// Copy the ascii at the start of the next 16 characters, when all of them would fit. Anything
+		// else stops the run and is handled one code point at a time below.
+		if (uint32_t(*aStringIn) - 1 < 0x7f && aBufferLength >= 16 && aCharacterLimit - written.Characters >= 16 &&
+			MSF_UTFCanLoadBlock(aStringIn, 16 * sizeof(CharFrom)))
+		{
+			__m128i chars;
+			uint32_t const ascii = MSF_UTFBlock<sizeof(CharFrom)>::Load(aStringIn, chars);
+			uint32_t const run = MSF_FirstSetBit(~ascii);
+			if (run)
+			{
+				if (aStringOut)
+				{
+					MSF_UTFBlock<sizeof(CharTo)>::Store(aStringOut, chars);
+					aStringOut += run;
+				}
+
+				aStringIn += run;
+				aBufferLength -= run;
+				written.Elements += run;
+				written.Characters += run;
+
+				if (run == 16)
+					continue;
+			}
+		}
+#endif
+		if (!*aStringIn)
+			break;
+
 		MSF_CodeRead const read = MSF_ReadCodePoint(aStringIn);
 		aStringIn += read.CharsRead;
 
@@ -213,8 +326,9 @@ MSF_CharactersWritten MSF_UTFCopyShared(CharTo* aStringOut, size_t aBufferLength
 		{
 			if (aBufferLength > 4 / sizeof(CharTo))
 			{
-				// fast copy just copy a whole 4 byte block as long as we have space
-				*(uint32_t*)aStringOut = Optim.Block;
+				// fast copy just copy a whole 4 byte block as long as we have space, the output isn't
+				// always aligned after copying runs of ascii
+				memcpy(aStringOut, &Optim.Block, sizeof(Optim.Block));
 			}
 			else
 			{
@@ -1,6 +1,14 @@
 #include "MSF_Utilities.h"
 #include "MSF_Assert.h"
 
+#if MSF_USE_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#endif
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 template <typename Char>
@@ -22,6 +30,103 @@ size_t MSF_Strlen(char16_t const* aString) { return MSF_StrlenShared(aString); }
 size_t MSF_Strlen(char32_t const* aString) { return MSF_StrlenShared(aString); }
 size_t MSF_Strlen(wchar_t const* aString) { return MSF_StrlenShared(aString); }
 //-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+Char const* MSF_FindFormatControlScalar(Char const* aString)
+{
+    for (;; ++aString)
+    {
+        switch (*aString)
+        {
+        case '\0':
+        case '%':
+        case '{':
+        case '}':
+            return aString;
+        }
+    }
+}
+#if MSF_USE_SIMD
+//-------------------------------------------------------------------------------------------------
+// Compare a block of characters against all the control characters, returns a bit per byte
+//-------------------------------------------------------------------------------------------------
+template <size_t CharSize>
+struct MSF_SimdScanner;
+
+#if defined(__AVX2__)
+typedef __m256i MSF_SimdBlock;
+#define MSF_SIMD_SCANNER(Size, Bits) \
+template <> struct MSF_SimdScanner<Size> \
+{ \
+    MSF_NO_SANITIZE_ADDRESS static uint32_t Find(MSF_SimdBlock const* aBlock) \
+    { \
+        MSF_SimdBlock const block = _mm256_load_si256(aBlock); \
+        MSF_SimdBlock const found = _mm256_or_si256( \
+            _mm256_or_si256(_mm256_cmpeq_epi##Bits(block, _mm256_set1_epi##Bits('%')), _mm256_cmpeq_epi##Bits(block, _mm256_set1_epi##Bits('{'))), \
+            _mm256_or_si256(_mm256_cmpeq_epi##Bits(block, _mm256_set1_epi##Bits('}')), _mm256_cmpeq_epi##Bits(block, _mm256_setzero_si256()))); \
+        return uint32_t(_mm256_movemask_epi8(found)); \
+    } \
+};
+#else
+typedef __m128i MSF_SimdBlock;
+#define MSF_SIMD_SCANNER(Size, Bits) \
+template <> struct MSF_SimdScanner<Size> \
+{ \
+    MSF_NO_SANITIZE_ADDRESS static uint32_t Find(MSF_SimdBlock const* aBlock) \
+    { \
+        MSF_SimdBlock const block = _mm_load_si128(aBlock); \
+        MSF_SimdBlock const found = _mm_or_si128( \
+            _mm_or_si128(_mm_cmpeq_epi##Bits(block, _mm_set1_epi##Bits('%')), _mm_cmpeq_epi##Bits(block, _mm_set1_epi##Bits('{'))), \
+            _mm_or_si128(_mm_cmpeq_epi##Bits(block, _mm_set1_epi##Bits('}')), _mm_cmpeq_epi##Bits(block, _mm_setzero_si128()))); \
+        return uint32_t(_mm_movemask_epi8(found)); \
+    } \
+};
+#endif
+
+MSF_SIMD_SCANNER(1, 8)
+MSF_SIMD_SCANNER(2, 16)
+MSF_SIMD_SCANNER(4, 32)
+#undef MSF_SIMD_SCANNER
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+template <typename Char>
+MSF_NO_SANITIZE_ADDRESS Char const* MSF_FindFormatControlShared(Char const* aString)
+{
+    // Aligned loads can't cross a page boundary, so reading past the null terminator is safe.
+    // Strings that aren't aligned to their own character size can't be split this way.
+    if ((uintptr_t)aString % sizeof(Char) != 0)
+        return MSF_FindFormatControlScalar(aString);
+
+    uintptr_t const offset = (uintptr_t)aString % sizeof(MSF_SimdBlock);
+    MSF_SimdBlock const* block = (MSF_SimdBlock const*)((uintptr_t)aString - offset);
+
+    // ignore anything before the start of the string in the first block
+    uint32_t found = MSF_SimdScanner<sizeof(Char)>::Find(block) >> offset;
+    if (found)
+        return (Char const*)((char const*)aString + MSF_FirstSetBit(found));
+
+    for (;;)
+    {
+        found = MSF_SimdScanner<sizeof(Char)>::Find(++block);
+        if (found)
+            return (Char const*)((char const*)block + MSF_FirstSetBit(found));
+    }
+}
+#else
+template <typename Char>
+Char const* MSF_FindFormatControlShared(Char const* aString)
+{
+    return MSF_FindFormatControlScalar(aString);
+}
+#endif // MSF_USE_SIMD
+//-------------------------------------------------------------------------------------------------
+char const* MSF_FindFormatControl(char const* aString) { return MSF_FindFormatControlShared(aString); }
+char8_t const* MSF_FindFormatControl(char8_t const* aString) { return (char8_t const*)MSF_FindFormatControlShared((char const*)aString); }
+char16_t const* MSF_FindFormatControl(char16_t const* aString) { return MSF_FindFormatControlShared(aString); }
+char32_t const* MSF_FindFormatControl(char32_t const* aString) { return MSF_FindFormatControlShared(aString); }
+wchar_t const* MSF_FindFormatControl(wchar_t const* aString) { return (wchar_t const*)MSF_FindFormatControlShared((MSF_WChar const*)aString); }
+//-------------------------------------------------------------------------------------------------
 // Helper to upgrade char/wchar into size_t for optimal copying
 //-------------------------------------------------------------------------------------------------
 inline size_t MSF_GrowValue(char32_t aValue)
@@ -2,6 +2,10 @@
 
 #include "MSF_Config.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 //-------------------------------------------------------------------------------------------------
 // Internal utilities to help with string formatting
 //-------------------------------------------------------------------------------------------------
@@ -59,6 +63,44 @@ constexpr Type MSF_IntAbs(Type aValue)
 	return MSF_IntAbs_private<Type>(aValue, aValue >> (sizeof(aValue) * 8 - 1));
 }
 
+//-------------------------------------------------------------------------------------------------
+// Get the index of the lowest set bit, aValue must not be 0
+//-------------------------------------------------------------------------------------------------
+inline uint32_t MSF_FirstSetBit(uint32_t aValue)
+{
+#if defined(_MSC_VER)
+	unsigned long result;
+	_BitScanForward(&result, aValue);
+	return result;
+#else
+	return uint32_t(__builtin_ctz(aValue));
+#endif
+}
+
+inline uint32_t MSF_FirstSetBit(uint64_t aValue)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long result;
+	_BitScanForward64(&result, aValue);
+	return result;
+#elif defined(_MSC_VER)
+	return uint32_t(aValue) ? MSF_FirstSetBit(uint32_t(aValue)) : 32 + MSF_FirstSetBit(uint32_t(aValue >> 32));
+#else
+	return uint32_t(__builtin_ctzll(aValue));
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+// Vector code reads whole blocks which can include characters past the end of the string
+//-------------------------------------------------------------------------------------------------
+#if defined(__clang__) || defined(__GNUC__)
+#define MSF_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER) && _MSC_VER >= 1928
+#define MSF_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+#define MSF_NO_SANITIZE_ADDRESS
+#endif
+
 //-------------------------------------------------------------------------------------------------
 // Simple string length functions. Not using std versions to allow for link time optimizations
 //-------------------------------------------------------------------------------------------------
@@ -68,6 +110,16 @@ extern size_t MSF_Strlen(char16_t const* aString);
 extern size_t MSF_Strlen(char32_t const* aString);
 extern size_t MSF_Strlen(wchar_t const* aString);
 
+//-------------------------------------------------------------------------------------------------
+// Find the first character that could start or end a print specifier ('%', '{' or '}') or the null
+// terminator. Used to skip over literal text, see MSF_USE_SIMD.
+//-------------------------------------------------------------------------------------------------
+extern char const* MSF_FindFormatControl(char const* aString);
+extern char8_t const* MSF_FindFormatControl(char8_t const* aString);
+extern char16_t const* MSF_FindFormatControl(char16_t const* aString);
+extern char32_t const* MSF_FindFormatControl(char32_t const* aString);
+extern wchar_t const* MSF_FindFormatControl(wchar_t const* aString);
+
 //-------------------------------------------------------------------------------------------------
 // This is equivalent to memset but safe by default.
 //-------------------------------------------------------------------------------------------------
@@ -111,7 +111,8 @@ void MSF_ValidationError(char const*);
 
 //-------------------------------------------------------------------------------------------------
 // Validator captures the incoming string and assumes that a sized string is known at compile time and
-// uses the compile time only branch to validate the format
+// uses the compile time only branch to validate the format. While validating it records every print
+// specifier so the string doesn't need to be parsed again at runtime.
 //-------------------------------------------------------------------------------------------------
 template <typename Char, typename... Args>
 struct MSF_Validator
@@ -141,16 +142,21 @@ struct MSF_Validator
 		uint64_t constexpr types[len+1] = { MSF_StringFormatTypeLookup<Args>::ID..., 0};
 
 		int numArgs = 0;
-		uint64_t usedArgs = 0;
+		bool usedArgs[len + 1] = {};
 		int printMode = 0; // 1 = auto, 2 = indexed
-		for (int i = 0; aString[i];)
+		int i = 0;
+		for (; aString[i];)
 		{
+			MSF_FormatSpecifier specifier = {};
+			specifier.myStart = i;
+
 			switch (aString[i++])
 			{
 			case '%':
 				if (aString[i] == '%')
 				{
 					++i;
+					++myNumEscapes;
 				}
 				else
 				{
@@ -159,6 +165,15 @@ struct MSF_Validator
 #endif
 					while (aString[i] == '-' || aString[i] == '+' || aString[i] == ' ' || aString[i] == '#' || aString[i] == '0')
 					{
+						switch (aString[i])
+						{
+						case '-': specifier.myFlags = (specifier.myFlags | PRINT_LEFTALIGN) & ~PRINT_ZERO; break;
+						case '+': specifier.myFlags |= PRINT_SIGN; break;
+						case ' ': specifier.myFlags |= PRINT_BLANK; break;
+						case '#': specifier.myFlags |= PRINT_PREFIX; break;
+						case '0': if (!(specifier.myFlags & PRINT_LEFTALIGN)) specifier.myFlags |= PRINT_ZERO; break;
+						}
+
 #if MSF_ERROR_PEDANTIC
 						if (hasFlag[(int)aString[i]])
 							MSF_ValidationError("Duplicate Flag Detected");
@@ -181,18 +196,25 @@ struct MSF_Validator
 						if ((MSF_ValidTypes<MSF_CharToTypesLookup<Char>>::GetType('d') & types[numArgs]) == 0)
 							MSF_ValidationError("Expected integer type for width wildcard");
 
-						usedArgs |= 1LL << numArgs;
+						specifier.myWildcards |= WILDCARD_WIDTH;
+						usedArgs[numArgs] = true;
 						++numArgs;
 						++i;
 					}
 					else
 					{
 						while (MSF_IsDigit(aString[i]))
-							++i;
+						{
+							uint32_t const value = specifier.myWidth * 10u + uint32_t(aString[i++] - '0');
+							if (value >= UINT16_MAX)
+								MSF_ValidationError("Width too large");
+							specifier.myWidth = uint16_t(value);
+						}
 					}
 
 					if (aString[i] == '.')
 					{
+						specifier.myFlags |= PRINT_PRECISION;
 						++i;
 
 						if (aString[i] == '*')
@@ -203,14 +225,20 @@ struct MSF_Validator
 							if ((MSF_ValidTypes<MSF_CharToTypesLookup<Char>>::GetType('d') & types[numArgs]) == 0)
 								MSF_ValidationError("Expected integer type for precision wildcard");
 
-							usedArgs |= 1LL << numArgs;
+							specifier.myWildcards |= WILDCARD_PRECISION;
+							usedArgs[numArgs] = true;
 							++numArgs;
 							++i;
 						}
 						else if (MSF_IsDigit(aString[i]))
 						{
 							while (MSF_IsDigit(aString[i]))
-								++i;
+							{
+								uint32_t const value = specifier.myPrecision * 10u + uint32_t(aString[i++] - '0');
+								if (value >= UINT16_MAX)
+									MSF_ValidationError("Precision too large");
+								specifier.myPrecision = uint16_t(value);
+							}
 						}
 					}
 
@@ -225,7 +253,9 @@ struct MSF_Validator
 						if ((MSF_ValidTypes<MSF_CharToTypesLookup<Char>>::GetType((char)aString[i]) & types[numArgs]) == 0)
 							MSF_ValidationError("Type mismatch");
 
-						usedArgs |= 1LL << numArgs;
+						specifier.myPrintChar = (char)aString[i++];
+						specifier.myArgument = uint8_t(numArgs);
+						usedArgs[numArgs] = true;
 						++numArgs;
 					}
 					else
@@ -236,12 +266,15 @@ struct MSF_Validator
 					if (printMode == 0) printMode = 1;
 					else if (printMode == 2)
 						MSF_ValidationError("Mismatched print modes, don't mix %x,{} with {N}");
+
+					AddSpecifier(specifier, i);
 				}
 				break;
 			case '{':
 				if (aString[i] == '{')
 				{
 					++i;
+					++myNumEscapes;
 				}
 				else
 				{
@@ -270,12 +303,21 @@ struct MSF_Validator
 					{
 						++i;
 						if (aString[i] == '-')
+						{
+							specifier.myFlags |= PRINT_LEFTALIGN;
 							++i;
+						}
 
 						if (!MSF_IsDigit(aString[i]))
 							MSF_ValidationError("Expected digit for width");
 
-						while (MSF_IsDigit(aString[i])) ++i;
+						while (MSF_IsDigit(aString[i]))
+						{
+							uint32_t const value = specifier.myWidth * 10u + uint32_t(aString[i++] - '0');
+							if (value >= UINT16_MAX)
+								MSF_ValidationError("Width too large");
+							specifier.myWidth = uint16_t(value);
+						}
 					}
 
 					if (aString[i] == ':')
@@ -291,23 +333,33 @@ struct MSF_Validator
 						if ((MSF_ValidTypes<MSF_CharToTypesLookup<Char>>::GetType((char)aString[i]) & types[index]) == 0)
 							MSF_ValidationError("Type mismatch");
 
-						++i;
+						specifier.myPrintChar = (char)aString[i++];
 
-						while (MSF_IsDigit(aString[i])) ++i;
+						while (MSF_IsDigit(aString[i]))
+						{
+							uint32_t const value = specifier.myPrecision * 10u + uint32_t(aString[i++] - '0');
+							if (value >= UINT16_MAX)
+								MSF_ValidationError("Precision too large");
+							specifier.myPrecision = uint16_t(value);
+						}
 					}
 
 					if (aString[i] != '}')
 						MSF_ValidationError("Expected closing brace");
 
-					usedArgs |= 1LL << index;
+					specifier.myArgument = uint8_t(index);
+					usedArgs[index] = true;
 					++numArgs;
 					++i;
+
+					AddSpecifier(specifier, i);
 				}
 				break;
 			case '}':
 				if (aString[i] == '}')
 				{
 					++i;
+					++myNumEscapes;
 				}
 				else
 				{
@@ -317,12 +369,37 @@ struct MSF_Validator
 			}
 		}
 
-		if (usedArgs != (1LL << len) - 1)
-			MSF_ValidationError("Not all arguments were used");
+		for (int arg = 0; arg < len; ++arg)
+		{
+			if (!usedArgs[arg])
+				MSF_ValidationError("Not all arguments were used");
+		}
+
+		// Specifiers only fit if every argument is printed once, otherwise leave it to the runtime
+		if (myNumSpecifiers <= theMaxSpecifiers)
+			myLength = i + 1;
+		else
+			myNumSpecifiers = 0;
 	}
 
 	constexpr operator Char const* () const { return myString; }
 
+	static constexpr uint32_t theMaxSpecifiers = sizeof...(Args);
+
+	constexpr void AddSpecifier(MSF_FormatSpecifier& aSpecifier, int anEnd)
+	{
+		aSpecifier.myEnd = anEnd;
+		if (myNumSpecifiers < theMaxSpecifiers)
+			mySpecifiers[myNumSpecifiers] = aSpecifier;
+		++myNumSpecifiers;
+	}
+
 	Char const* myString;
 	char const* myError = nullptr; // Mainly for unit tests
+
+	// Only set when validated at compile time
+	MSF_FormatSpecifier mySpecifiers[theMaxSpecifiers ? theMaxSpecifiers : 1] = {};
+	uint32_t myNumSpecifiers = 0;
+	uint32_t myNumEscapes = 0;
+	uint32_t myLength = 0;
 };